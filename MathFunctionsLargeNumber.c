@@ -11,664 +11,6738 @@
  |	Dependancy:	stdio.h,	stdlib.h,	inttypes.h
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-#include "LargeNumber.h"
+#include "MathFunctionsLargeNumber.h"
+
+#if !defined(LARGENUMBER_BINARY) && (defined(__AVX512F__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+#if defined(LARGENUMBER_POSIX)
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define MIN_CAPACITY	4				//Smallest amount of segments allocated to a number.
+
+static large_number* init_sized_largenumber(size_t size);
+static void trim_largenumber(large_number* number);
+static large_number* value_largenumber(large_number* holding, segment* holding_segments,
+									   long long value);
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	SEGMENT ARRAY OPERATIONS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	compare_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Compares the magnitude of two trimmed segment arrays.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length.
+ |	@return:	1,					The first array is larger.
+ |				0,					The arrays are equal.
+ |				-1,					The second array is larger.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int compare_segments(const segment* one, size_t size_one,
+							const segment* two, size_t size_two){
+	size_t i;
+
+	if( size_one != size_two){
+		return size_one > size_two ? 1 : -1;
+	}
+	///The first segment from the most significant end that differs decides the result.
+	for( i = size_one; i > 0; i--){
+		if( one[i-1] != two[i-1]){
+			return one[i-1] > two[i-1] ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+#if !defined(LARGENUMBER_BINARY) && (defined(__AVX512F__) || defined(__AVX2__))
+#if defined(__AVX512F__)
+#define SIMD_LANES		16				//Segments added at once by the vector kernels.
+#else
+#define SIMD_LANES		8
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	carry_chain
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the carry into every lane of a vector of sums at once, as a carry
+ |				lookahead adder would.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		generate,			A bit for every lane that carries out by itself.
+ |				propagate,			A bit for every lane that carries out only when a carry
+ |									comes into it.
+ |				carry,				The carry into the lowest lane.
+ |	@return:	A bit for the carry into every lane, followed by the carry out of the last.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Adding the lanes as binary digits lets the carries ripple through the
+ |				integer adder, with the propagating lanes as ones and the generating lanes
+ |				as twos.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned int carry_chain(unsigned int generate, unsigned int propagate, segment carry){
+	return ((generate | propagate) + generate + carry) ^ propagate;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_lanes
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two segment arrays SIMD_LANES segments at a time with vector
+ |				instructions.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the sum is written, may be either array.
+ |				one, two, size,		The arrays and their length.
+ |				carry,				The carry in, replaced by the carry out.
+ |	@return:	The amount of segments added, a multiple of SIMD_LANES.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t add_lanes(segment* result, const segment* one, const segment* two, size_t size,
+						segment* carry){
+	unsigned int chain;
+	size_t i;
+#if defined(__AVX512F__)
+	const __m512i base = _mm512_set1_epi32(MAXVALUE), top = _mm512_set1_epi32(MAXVALUE - 1);
+	const __m512i unit = _mm512_set1_epi32(1);
+	__m512i sum;
+
+	for( i = 0; i + SIMD_LANES <= size; i += SIMD_LANES){
+		sum = _mm512_add_epi32(_mm512_loadu_si512(one + i), _mm512_loadu_si512(two + i));
+		chain = carry_chain(_mm512_cmpgt_epi32_mask(sum, top), _mm512_cmpeq_epi32_mask(sum, top),
+							*carry);
+		sum = _mm512_mask_add_epi32(sum, (__mmask16) chain, sum, unit);
+		sum = _mm512_mask_sub_epi32(sum, _mm512_cmpgt_epi32_mask(sum, top), sum, base);
+		_mm512_storeu_si512(result + i, sum);
+		*carry = chain >> SIMD_LANES;
+	}
+#else
+	const __m256i base = _mm256_set1_epi32(MAXVALUE), top = _mm256_set1_epi32(MAXVALUE - 1);
+	const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+	__m256i sum, carries;
+
+	for( i = 0; i + SIMD_LANES <= size; i += SIMD_LANES){
+		sum = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*) (one + i)),
+							   _mm256_loadu_si256((const __m256i*) (two + i)));
+		chain = carry_chain(
+			_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sum, top))),
+			_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, top))), *carry);
+		//The carry bits are spread back over the lanes, as zero or minus one.
+		carries = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int) chain), bits), bits);
+		sum = _mm256_sub_epi32(sum, carries);
+		sum = _mm256_sub_epi32(sum, _mm256_and_si256(_mm256_cmpgt_epi32(sum, top), base));
+		_mm256_storeu_si256((__m256i*) (result + i), sum);
+		*carry = chain >> SIMD_LANES;
+	}
+#endif
+	return i;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sub_lanes
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Negates one segment array from another SIMD_LANES segments at a time with
+ |				vector instructions.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the result is written, may be either array.
+ |				one, two, size,		The arrays, two being negated from one, and their length.
+ |				borrow,				The borrow in, replaced by the borrow out.
+ |	@return:	The amount of segments negated, a multiple of SIMD_LANES.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Borrows move through the lanes in the same way carries do, with a negative
+ |				difference generating one and a zero difference propagating it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t sub_lanes(segment* result, const segment* one, const segment* two, size_t size,
+						segment* borrow){
+	unsigned int chain;
+	size_t i;
+#if defined(__AVX512F__)
+	const __m512i base = _mm512_set1_epi32(MAXVALUE), zero = _mm512_setzero_si512();
+	const __m512i unit = _mm512_set1_epi32(1);
+	__m512i difference;
+
+	for( i = 0; i + SIMD_LANES <= size; i += SIMD_LANES){
+		difference = _mm512_sub_epi32(_mm512_loadu_si512(one + i), _mm512_loadu_si512(two + i));
+		chain = carry_chain(_mm512_cmplt_epi32_mask(difference, zero),
+							_mm512_cmpeq_epi32_mask(difference, zero), *borrow);
+		difference = _mm512_mask_sub_epi32(difference, (__mmask16) chain, difference, unit);
+		difference = _mm512_mask_add_epi32(difference,
+										   _mm512_cmplt_epi32_mask(difference, zero),
+										   difference, base);
+		_mm512_storeu_si512(result + i, difference);
+		*borrow = chain >> SIMD_LANES;
+	}
+#else
+	const __m256i base = _mm256_set1_epi32(MAXVALUE), zero = _mm256_setzero_si256();
+	const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+	__m256i difference, borrows;
+
+	for( i = 0; i + SIMD_LANES <= size; i += SIMD_LANES){
+		difference = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*) (one + i)),
+									  _mm256_loadu_si256((const __m256i*) (two + i)));
+		chain = carry_chain(
+			_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, difference))),
+			_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(difference, zero))),
+			*borrow);
+		borrows = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int) chain), bits), bits);
+		difference = _mm256_add_epi32(difference, borrows);
+		difference = _mm256_add_epi32(difference,
+									  _mm256_and_si256(_mm256_cmpgt_epi32(zero, difference), base));
+		_mm256_storeu_si256((__m256i*) (result + i), difference);
+		*borrow = chain >> SIMD_LANES;
+	}
+#endif
+	return i;
+}
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two segment arrays, the first being at least as long as the second.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one segment sum is written, may be
+ |									either of the arrays being added.
+ |				one, size_one,		The longer array and its length.
+ |				two, size_two,		The shorter array and its length.
+ |	@return:	The carry out of the most significant segment, zero or one.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Where vector instructions are enabled, blocks of segments are added by
+ |				add_lanes first.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment add_segments(segment* result, const segment* one, size_t size_one,
+							const segment* two, size_t size_two){
+	unsigned long long value_adding;
+	segment carry = 0;
+	size_t i = 0;
+
+#if defined(SIMD_LANES)
+	i = add_lanes(result, one, two, size_two, &carry);
+#endif
+	///The carry is found by comparing against MAXVALUE rather than dividing by it.
+	for( ; i < size_two; i++){
+		value_adding = (unsigned long long) one[i] + two[i] + carry;
+		carry = value_adding >= MAXVALUE;
+		result[i] = (segment) (carry ? value_adding - MAXVALUE : value_adding);
+	}
+	///Once the shorter array ends, only the carry needs to be moved through.
+	for( ; i < size_one; i++){
+		value_adding = (unsigned long long) one[i] + carry;
+		carry = value_adding >= MAXVALUE;
+		result[i] = (segment) (carry ? value_adding - MAXVALUE : value_adding);
+	}
+	return carry;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sub_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Negates a segment array from another, the first being at least as long as
+ |				the second.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one segment result is written, may be
+ |									either of the arrays.
+ |				one, size_one,		The array being negated from and its length.
+ |				two, size_two,		The array being negated and its length.
+ |	@return:	The borrow out of the most significant segment, zero or one.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Where vector instructions are enabled, blocks of segments are negated by
+ |				sub_lanes first.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment sub_segments(segment* result, const segment* one, size_t size_one,
+							const segment* two, size_t size_two){
+	unsigned long long negating;
+	segment borrow = 0;
+	size_t i = 0;
+
+#if defined(SIMD_LANES)
+	i = sub_lanes(result, one, two, size_two, &borrow);
+#endif
+	for( ; i < size_two; i++){
+		negating = (unsigned long long) two[i] + borrow;
+		if( one[i] >= negating){
+			result[i] = (segment) (one[i] - negating);
+			borrow = 0;
+		}
+		else{
+			//To make sure overflow does not occur, the value is taken from the next segment.
+			result[i] = (segment) (MAXVALUE - negating + one[i]);
+			borrow = 1;
+		}
+	}
+	for( ; i < size_one; i++){
+		if( one[i] >= borrow){
+			result[i] = one[i] - borrow;
+			borrow = 0;
+		}
+		else{
+			result[i] = MAXVALUE - 1;
+		}
+	}
+	return borrow;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_segment
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies a segment array by a single segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size segment product is written, may be number.
+ |				number, size,		The array being multiplied and its length.
+ |				value_multiplying,	The segment it is multiplied by.
+ |	@return:	The segment carried out of the most significant segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment multiply_segment(segment* result, const segment* number, size_t size,
+								segment value_multiplying){
+	unsigned long long value_adding = 0;
+	size_t i;
+
+	for( i = 0; i < size; i++){
+		value_adding += (unsigned long long) number[i] * value_multiplying;
+		result[i] = value_adding % MAXVALUE;
+		value_adding /= MAXVALUE;
+	}
+	return (segment) value_adding;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	addmul_segment
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds the product of a segment array and a single segment onto another array.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				The size segments the product is added to.
+ |				number, size,		The array being multiplied and its length.
+ |				value_multiplying,	The segment it is multiplied by.
+ |	@return:	The segment carried out of the most significant segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment addmul_segment(segment* result, const segment* number, size_t size,
+							  segment value_multiplying){
+	unsigned long long value_adding = 0;
+	size_t i;
+
+	for( i = 0; i < size; i++){
+		value_adding += (unsigned long long) number[i] * value_multiplying + result[i];
+		result[i] = value_adding % MAXVALUE;
+		value_adding /= MAXVALUE;
+	}
+	return (segment) value_adding;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_high
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the upper 64 bits of the 128 bit product of two values.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		one, two,			The values being multiplied.
+ |	@return:	The product divided by 2^64.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned long long multiply_high(unsigned long long one, unsigned long long two){
+#if defined(__SIZEOF_INT128__)
+	return (unsigned long long) (((unsigned __int128) one * two) >> 64);
+#else
+	unsigned long long one_low = one & 0xFFFFFFFFULL, one_high = one >> 32;
+	unsigned long long two_low = two & 0xFFFFFFFFULL, two_high = two >> 32;
+	unsigned long long middle = one_high * two_low + ((one_low * two_low) >> 32);
+	unsigned long long middle_other = one_low * two_high + (middle & 0xFFFFFFFFULL);
+
+	return one_high * two_high + (middle >> 32) + (middle_other >> 32);
+#endif
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divide_segment
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a segment array by a single value.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size segment quotient is written, may be number,
+ |									or NULL if only the remainder is wanted.
+ |				number, size,		The array being divided and its length.
+ |				divisor,			The non zero value it is divided by, which may be as
+ |									large as the segment type allows.
+ |	@return:	The remainder of the division.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		A reciprocal of the divisor is found once, so each segment only needs a
+ |				multiplication and at most one correction instead of a hardware divide.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment divide_segment(segment* result, const segment* number, size_t size,
+							  segment divisor){
+	unsigned long long remainder = 0, estimate;
+	unsigned long long inverse = ~0ULL / divisor;
+	size_t i;
+
+	///Starting from the most significant segment, the remainder is carried down. The
+	///estimate is at most one too small in base 10^9, and two in base 2^32.
+	for( i = size; i > 0; i--){
+		remainder = remainder * MAXVALUE + number[i-1];
+		estimate = multiply_high(remainder, inverse);
+		remainder -= estimate * divisor;
+		while( remainder >= divisor){
+			remainder -= divisor;
+			estimate++;
+		}
+		if( result != NULL){
+			result[i-1] = (segment) estimate;
+		}
+	}
+	return (segment) remainder;
+}
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	SEGMENT POOL AND ARENAS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL	__declspec(thread)
+#else
+#define THREAD_LOCAL	__thread
+#endif
+
+#define POOL_CLASSES		11				//Segment arrays of 4 up to 4096 are pooled.
+#define POOL_MAX_CAPACITY	(MIN_CAPACITY << (POOL_CLASSES - 1))
+#define POOL_CLASS_BYTES	262144			//Most free memory a thread keeps per size class.
+#define ARENA_CHUNK_BYTES	65536			//Least memory taken from the system per chunk.
+#define ARENA_ALIGN			16
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		pool_block
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	A free block in the pool, which holds the next free block of its size.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+typedef struct pool_block{
+	struct pool_block* next;
+} pool_block;
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		arena_chunk
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	A chunk of memory an arena hands out, linked to the chunks before it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+typedef struct arena_chunk{
+	struct arena_chunk* prev;
+	size_t size;
+} arena_chunk;
+
+struct largenumber_arena{
+	arena_chunk* chunks;
+	char* next;								//The next free byte in the newest chunk.
+	size_t left;							//Bytes left in the newest chunk.
+};
+
+///Every thread keeps its own free lists, so no locking is needed to allocate or release.
+///A block released by another thread than the one that allocated it joins the free list
+///of the releasing thread, which is safe as every block is its own allocation.
+static THREAD_LOCAL pool_block* segment_pool[POOL_CLASSES];
+static THREAD_LOCAL size_t segment_pool_count[POOL_CLASSES];
+static THREAD_LOCAL pool_block* number_pool;
+static THREAD_LOCAL size_t number_pool_count;
+static THREAD_LOCAL largenumber_arena* current_arena;
+#if defined(LARGENUMBER_POSIX)
+static THREAD_LOCAL int pool_registered;	//The thread releases its pool when it exits.
+static pthread_once_t pool_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t pool_key;
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	largenumber_pool_trim
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gives every free block the calling thread keeps back to the system.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		This is done when a thread exits on posix systems. Elsewhere a thread
+ |				should call it before exiting, or its free blocks are never released.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void largenumber_pool_trim(void){
+	pool_block* todelete;
+	size_t size_class;
+
+	for( size_class = 0; size_class < POOL_CLASSES; size_class++){
+		while( (todelete = segment_pool[size_class]) != NULL){
+			segment_pool[size_class] = todelete->next;
+			free(todelete);
+		}
+		segment_pool_count[size_class] = 0;
+	}
+	while( (todelete = number_pool) != NULL){
+		number_pool = todelete->next;
+		free(todelete);
+	}
+	number_pool_count = 0;
+}
+
+#if defined(LARGENUMBER_POSIX)
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	release_pool
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Releases the pool of a thread that is exiting.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		unused				The value the thread set for the pool key.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void release_pool(void* unused){
+	(void) unused;
+	pool_registered = 0;
+	largenumber_pool_trim();
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	make_pool_key
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Creates the key whose destructor releases the pool of an exiting thread.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void make_pool_key(void){
+	pthread_key_create(&pool_key, release_pool);
+}
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	take_block
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Takes a block from a free list, or from the system if the list is empty.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		pool, count,		The free list and the amount of blocks in it.
+ |				block_bytes,		The size of every block in the list.
+ |	@return:	The block, which is not cleared.
+ |				NULL,				Allocation of memory failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void* take_block(pool_block** pool, size_t* count, size_t block_bytes){
+	pool_block* block;
+
+	if( (block = *pool) == NULL){
+		return malloc(block_bytes);
+	}
+	*pool = block->next;
+	(*count)--;
+
+	return block;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	give_block
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Puts a block on a free list, or gives it back to the system once the list
+ |				holds POOL_CLASS_BYTES of blocks.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		pool, count,		The free list and the amount of blocks in it.
+ |				block,				The block being released.
+ |				block_bytes,		The size of every block in the list.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void give_block(pool_block** pool, size_t* count, pool_block* block, size_t block_bytes){
+	if( *count >= POOL_CLASS_BYTES / block_bytes){
+		free(block);
+		return;
+	}
+#if defined(LARGENUMBER_POSIX)
+	///The first block kept by a thread has its pool released when the thread exits.
+	if( !pool_registered && pthread_once(&pool_key_once, make_pool_key) == 0
+	   && pthread_setspecific(pool_key, &pool_key) == 0){
+		pool_registered = 1;
+	}
+#endif
+	block->next = *pool;
+	*pool = block;
+	(*count)++;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	arena_alloc
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Hands out memory from an arena, adding a chunk to it when it is full.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		arena,				The arena the memory is taken from.
+ |				bytes,				The amount of memory needed.
+ |	@return:	The memory, which lives until the arena is freed.
+ |				NULL,				Allocation of memory failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void* arena_alloc(largenumber_arena* arena, size_t bytes){
+	arena_chunk* chunk;
+	size_t chunk_bytes;
+	void* taken;
+
+	bytes = (bytes + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+	if( bytes > arena->left){
+		chunk_bytes = bytes > ARENA_CHUNK_BYTES ? bytes : ARENA_CHUNK_BYTES;
+		if( (chunk = malloc(ARENA_ALIGN + chunk_bytes)) == NULL){
+			return NULL;
+		}
+		chunk->prev = arena->chunks;
+		chunk->size = chunk_bytes;
+		arena->chunks = chunk;
+		arena->next = (char*) chunk + ARENA_ALIGN;
+		arena->left = chunk_bytes;
+	}
+	taken = arena->next;
+	arena->next += bytes;
+	arena->left -= bytes;
+
+	return taken;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	alloc_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Allocates a segment array from an arena, the pool, or the system for arrays
+ |				too large to pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		capacity,			The amount of segments needed, rounded up to the
+ |									amount actually allocated.
+ |				arena,				The arena to allocate from, or NULL to use the pool.
+ |	@return:	The allocated segments, which are not cleared.
+ |				NULL,				Allocation of memory failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment* alloc_segments(size_t* capacity, largenumber_arena* arena){
+	size_t class_capacity = MIN_CAPACITY, size_class = 0;
+
+	if( arena != NULL){
+		return arena_alloc(arena, *capacity * sizeof(segment));
+	}
+	if( *capacity > POOL_MAX_CAPACITY){
+		return malloc(*capacity * sizeof(segment));
+	}
+	///The capacity is rounded up to the size class it is taken from.
+	while( class_capacity < *capacity){
+		class_capacity <<= 1;
+		size_class++;
+	}
+	*capacity = class_capacity;
+
+	return take_block(&segment_pool[size_class], &segment_pool_count[size_class],
+					  class_capacity * sizeof(segment));
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	release_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gives a segment array back to where it was allocated from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		releasing,			The segments being released.
+ |				capacity,			The amount of segments that were allocated.
+ |				arena,				The arena they came from, or NULL for the pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void release_segments(segment* releasing, size_t capacity, largenumber_arena* arena){
+	pool_block* block = (pool_block*) releasing;
+	size_t size_class = 0;
+
+	///Arena memory is only released when the whole arena is.
+	if( arena != NULL || releasing == NULL){
+		return;
+	}
+	if( capacity > POOL_MAX_CAPACITY){
+		free(releasing);
+		return;
+	}
+	while( ((size_t) MIN_CAPACITY << size_class) < capacity){
+		size_class++;
+	}
+	give_block(&segment_pool[size_class], &segment_pool_count[size_class], block,
+			   ((size_t) MIN_CAPACITY << size_class) * sizeof(segment));
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	alloc_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Allocates the memory for a large number itself, from the current arena if
+ |				one is in use, otherwise from the pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The allocated large number, with its arena set.
+ |				NULL,				Allocation of memory failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* alloc_largenumber(void){
+	large_number* making_largenumber;
+
+	if( current_arena != NULL){
+		making_largenumber = arena_alloc(current_arena, sizeof(large_number));
+	}
+	else{
+		making_largenumber = take_block(&number_pool, &number_pool_count, sizeof(large_number));
+	}
+	if( making_largenumber != NULL){
+		making_largenumber->arena = current_arena;
+	}
+
+	return making_largenumber;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	release_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gives the memory of a large number itself back to the pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		releasing			The large number being released.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void release_largenumber(large_number* releasing){
+	pool_block* block = (pool_block*) releasing;
+
+	if( releasing->arena != NULL){
+		return;
+	}
+	give_block(&number_pool, &number_pool_count, block, sizeof(large_number));
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_largenumber_arena
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Initialise function for an arena large numbers can be allocated from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	making_arena,		The initialisation was a success.
+ |				NULL,				Allocation of memory failed, intialisation unsuccessful.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_arena* init_largenumber_arena(void){
+	largenumber_arena* making_arena;
+
+	if( (making_arena = malloc(sizeof(largenumber_arena))) == NULL){
+		return NULL;
+	}
+	making_arena->chunks = NULL;
+	making_arena->next = NULL;
+	making_arena->left = 0;
+
+	return making_arena;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	use_largenumber_arena
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the arena every large number made by the calling thread is allocated
+ |				from, until another is set. The numbers a calculation only works in are
+ |				still taken from the pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		arena				The arena to use, or NULL to go back to the pool.
+ |	@return:	The arena that was being used before, so it can be restored.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_arena* use_largenumber_arena(largenumber_arena* arena){
+	largenumber_arena* previous = current_arena;
+
+	current_arena = arena;
+	return previous;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	free_largenumber_arena
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Frees an arena along with every large number allocated from it. If it is
+ |				the arena in use, the thread goes back to the pool.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		arena				The arena being freed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void free_largenumber_arena(largenumber_arena* arena){
+	arena_chunk* todelete;
+
+	if( arena == NULL){
+		return;
+	}
+	if( current_arena == arena){
+		current_arena = NULL;
+	}
+	while( (todelete = arena->chunks) != NULL){
+		arena->chunks = todelete->prev;
+		free(todelete);
+	}
+	free(arena);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	restore_arena
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Goes back to the arena that was put aside while a calculation made its
+ |				working numbers from the pool, and moves the result of it into the arena.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				The result made from the pool, or NULL.
+ |				arena,				The arena that was put aside, or NULL for none.
+ |	@return:	The result, allocated from the arena if there is one.
+ |				NULL,				The result was NULL, or moving it failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Only the numbers a caller is given are taken from their arena, so the
+ |				memory of a calculation does not stay in the arena until it is freed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* restore_arena(large_number* result, largenumber_arena* arena){
+	large_number* moved;
+
+	current_arena = arena;
+	if( result == NULL || result->arena == arena){
+		return result;
+	}
+	moved = copy_largenumber(result);
+	free_largenumber(result);
+
+	return moved;
+}
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	MULTIPLICATION ALGORITHMS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+#define KARATSUBA_THRESHOLD	32				//Default segments before karatsuba is used.
+/*
+ *	The transforms take over from karatsuba at NTT_THRESHOLD, so toom-cook only multiplies
+ *	numbers too long for a transform, splitting them into pieces still longer than these.
+ */
+#define TOOM3_THRESHOLD		2000			//Default segments before toom-3 is used.
+#define TOOM4_THRESHOLD		6000			//Default segments before toom-4 is used.
+#define TOOM_MAX_POINTS		7
+#define NTT_THRESHOLD		800				//Default segments before transforms are used.
+#define NTT_PRIMES			3
+#if defined(LARGENUMBER_BINARY)
+#define NTT_MAX_LENGTH		((size_t) 1 << 22)	//Largest transform all three primes allow.
+#else
+#define NTT_MAX_LENGTH		((size_t) 1 << 23)	//Largest transform all three primes allow.
+#endif
+
+static size_t karatsuba_threshold = KARATSUBA_THRESHOLD;
+static size_t toom3_threshold = TOOM3_THRESHOLD;
+static size_t toom4_threshold = TOOM4_THRESHOLD;
+static size_t ntt_threshold = NTT_THRESHOLD;
+
+static int multiply_segments(segment* result, const segment* one, size_t size_one,
+							 const segment* two, size_t size_two);
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	trimmed_size
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the length of a segment array without its leading zeros.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number, size,		The array and its length.
+ |	@return:	The length without leading zeros, zero if every segment is zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t trimmed_size(const segment* number, size_t size){
+	while( size > 0 && number[size - 1] == 0){
+		size--;
+	}
+	return size;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	difference_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the absolute difference of two segment arrays that may have leading
+ |				zeros.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the difference is written, padded to size segments.
+ |				one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length.
+ |				size,				The length of the result, at least either trimmed length.
+ |	@return:	1,					The first array was smaller, so the difference is negative.
+ |				0,					The difference is positive.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int difference_segments(segment* result, const segment* one, size_t size_one,
+							   const segment* two, size_t size_two, size_t size){
+	int negative;
+
+	size_one = trimmed_size(one, size_one);
+	size_two = trimmed_size(two, size_two);
+	memset(result, 0, size * sizeof(segment));
+	if( (negative = compare_segments(one, size_one, two, size_two) < 0)){
+		sub_segments(result, two, size_two, one, size_one);
+	}
+	else{
+		sub_segments(result, one, size_one, two, size_two);
+	}
+	return negative;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	multiply_segments_basecase
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two segment arrays together using the schoolbook method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void multiply_segments_basecase(segment* result, const segment* one, size_t size_one,
+									   const segment* two, size_t size_two){
+	size_t i;
+
+	result[size_one] = multiply_segment(result, one, size_one, two[0]);
+	///Every further segment of the second array adds a partial product, offset by its
+	///position, directly onto the result.
+	for( i = 1; i < size_two; i++){
+		result[size_one + i] = addmul_segment(result + i, one, size_one, two[i]);
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	square_segments_basecase
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Squares a segment array using the schoolbook method, finding every cross
+ |				product only once.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the 2 * size segment square is written, must not
+ |									overlap the array.
+ |				number, size,		The array and its length.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void square_segments_basecase(segment* result, const segment* number, size_t size){
+	unsigned long long square, low, high, carry = 0;
+	size_t i;
+
+	///The products of every segment with those above it are summed, and then doubled as
+	///each appears twice in the square.
+	memset(result, 0, 2 * size * sizeof(segment));
+	for( i = 0; i + 1 < size; i++){
+		result[size + i] = addmul_segment(result + 2 * i + 1, number + i + 1, size - i - 1,
+										  number[i]);
+	}
+	add_segments(result, result, 2 * size, result, 2 * size);
+
+	///The square of every segment is then added on the diagonal.
+	for( i = 0; i < size; i++){
+		square = (unsigned long long) number[i] * number[i];
+		low = result[2 * i] + square % MAXVALUE + carry;
+		high = result[2 * i + 1] + square / MAXVALUE + low / MAXVALUE;
+		result[2 * i] = low % MAXVALUE;
+		result[2 * i + 1] = high % MAXVALUE;
+		carry = high / MAXVALUE;
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	karatsuba_scratch
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the amount of scratch segments karatsuba_segments needs.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		size_one,			The length of the longer array.
+ |				size_two,			The length of the shorter array.
+ |	@return:	The amount of scratch segments needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t karatsuba_scratch(size_t size_one, size_t size_two){
+	size_t half = (size_one + 1) / 2;
+
+	if( size_two < karatsuba_threshold){
+		return 0;
+	}
+	if( size_two <= half){
+		return 2 * size_two + karatsuba_scratch(size_two, size_two);
+	}
+	return 6 * half + 1 + karatsuba_scratch(half, half);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	karatsuba_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two segment arrays together using karatsuba's method, which
+ |				replaces four half sized products with three.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The longer array and its length.
+ |				two, size_two,		The shorter array and its length.
+ |				scratch,			At least karatsuba_scratch segments of working space.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		With one = one_high*B + one_low and two = two_high*B + two_low, the middle
+ |				part of the product is one_low*two_low + one_high*two_high
+ |				- (one_low - one_high)*(two_low - two_high).
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void karatsuba_segments(segment* result, const segment* one, size_t size_one,
+							   const segment* two, size_t size_two, segment* scratch){
+	size_t half = (size_one + 1) / 2, offset, length, high_size, middle_size;
+	segment* diff_one, *diff_two, *diff_product, *middle, *next_scratch;
+	int negative;
+
+	if( size_two < karatsuba_threshold){
+		multiply_segments_basecase(result, one, size_one, two, size_two);
+		return;
+	}
+
+	///If the shorter array is at most half the longer, the longer one is split into blocks
+	///the size of the shorter one, and each block product is added into the result.
+	if( size_two <= half){
+		karatsuba_segments(result, one, size_two, two, size_two, scratch + 2 * size_two);
+		memset(result + 2 * size_two, 0, (size_one - size_two) * sizeof(segment));
+
+		for( offset = size_two; offset < size_one; offset += size_two){
+			length = size_one - offset < size_two ? size_one - offset : size_two;
+			karatsuba_segments(scratch, two, size_two, one + offset, length,
+							   scratch + 2 * size_two);
+			add_segments(result + offset, result + offset, size_one + size_two - offset,
+						 scratch, size_two + length);
+		}
+		return;
+	}
+
+	diff_one = scratch;
+	diff_two = diff_one + half;
+	diff_product = diff_two + half;
+	middle = diff_product + 2 * half;
+	next_scratch = middle + 2 * half + 1;
+
+	///The product of the differences of the halves is found first, as it only needs the
+	///scratch space.
+	negative = difference_segments(diff_one, one, half, one + half, size_one - half, half);
+	negative ^= difference_segments(diff_two, two, half, two + half, size_two - half, half);
+	karatsuba_segments(diff_product, diff_one, half, diff_two, half, next_scratch);
+
+	///The low and high products are built straight into their places in the result.
+	karatsuba_segments(result, one, half, two, half, next_scratch);
+	karatsuba_segments(result + 2 * half, one + half, size_one - half,
+					   two + half, size_two - half, next_scratch);
+
+	///The middle part is put together from the three products, and added on at its offset.
+	high_size = size_one + size_two - 2 * half;
+	memcpy(middle, result, 2 * half * sizeof(segment));
+	middle[2 * half] = 0;
+	add_segments(middle, middle, 2 * half + 1, result + 2 * half, high_size);
+	if( negative){
+		add_segments(middle, middle, 2 * half + 1, diff_product, 2 * half);
+	}
+	else{
+		sub_segments(middle, middle, 2 * half + 1, diff_product, 2 * half);
+	}
+	middle_size = trimmed_size(middle, 2 * half + 1);
+	add_segments(result + half, result + half, size_one + size_two - half, middle, middle_size);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	karatsuba_square_scratch
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the amount of scratch segments karatsuba_square needs.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		size,				The length of the array being squared.
+ |	@return:	The amount of scratch segments needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t karatsuba_square_scratch(size_t size){
+	size_t half = (size + 1) / 2;
+
+	if( size < karatsuba_threshold){
+		return 0;
+	}
+	return 5 * half + 1 + karatsuba_square_scratch(half);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	karatsuba_square
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Squares a segment array using karatsuba's method, with three half sized
+ |				squares.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the 2 * size segment square is written, must not
+ |									overlap the array.
+ |				number, size,		The array and its length.
+ |				scratch,			At least karatsuba_square_scratch segments of working
+ |									space.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		With number = high*B + low, the middle part of the square is
+ |				low^2 + high^2 - (low - high)^2, and the squared difference is never
+ |				negative, so its sign does not need to be tracked.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void karatsuba_square(segment* result, const segment* number, size_t size,
+							 segment* scratch){
+	size_t half = (size + 1) / 2, middle_size;
+	segment* difference, *difference_square, *middle, *next_scratch;
+
+	if( size < karatsuba_threshold){
+		square_segments_basecase(result, number, size);
+		return;
+	}
+
+	difference = scratch;
+	difference_square = difference + half;
+	middle = difference_square + 2 * half;
+	next_scratch = middle + 2 * half + 1;
+
+	difference_segments(difference, number, half, number + half, size - half, half);
+	karatsuba_square(difference_square, difference, half, next_scratch);
+	karatsuba_square(result, number, half, next_scratch);
+	karatsuba_square(result + 2 * half, number + half, size - half, next_scratch);
+
+	memcpy(middle, result, 2 * half * sizeof(segment));
+	middle[2 * half] = 0;
+	add_segments(middle, middle, 2 * half + 1, result + 2 * half, 2 * (size - half));
+	sub_segments(middle, middle, 2 * half + 1, difference_square, 2 * half);
+	middle_size = trimmed_size(middle, 2 * half + 1);
+	add_segments(result + half, result + half, 2 * size - half, middle, middle_size);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	piece_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets up a positive large number that reads part of a segment array, so the
+ |				part can be used by the large number operations without copying it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		holding,			The large number being set up.
+ |				segments, size,		The part of the array and its length, which may be zero.
+ |	@return:	holding,			The large number that was set up.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* piece_largenumber(large_number* holding, const segment* segments,
+									   size_t size){
+	static segment zero_segment = 0;
+
+	size = trimmed_size(segments, size);
+	holding->segments = size > 0 ? (segment*) segments : &zero_segment;
+	holding->size = size > 0 ? size : 1;
+	holding->capacity = holding->size;
+	holding->sign = POSITIVE;
+	holding->decimal_position = 0;
+	holding->max_dec_places = 0;
+	holding->arena = NULL;
+
+	return holding;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	toom_evaluate
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Evaluates the polynomial formed by splitting a segment array into pieces at
+ |				a small point, using horner's method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number, size,		The array and its length.
+ |				pieces,				The amount of pieces the array is split into.
+ |				piece_size,			The length of every piece but the last.
+ |				point,				The point the polynomial is evaluated at.
+ |	@return:	evaluated,			The value of the polynomial at the point.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* toom_evaluate(const segment* number, size_t size, int pieces,
+								   size_t piece_size, int point){
+	large_number* evaluated;				//Return value.
+	large_number piece, multiplying;
+	segment multiplying_segments[3];
+	size_t start, length;
+	int i;
+
+	if( (evaluated = init_sized_largenumber(piece_size + 2)) == NULL){
+		return NULL;
+	}
+	evaluated->size = 1;
+	value_largenumber(&multiplying, multiplying_segments, point);
+
+	///Starting from the most significant piece, the value is multiplied by the point and
+	///the next piece is added.
+	for( i = pieces - 1; i >= 0; i--){
+		start = i * piece_size;
+		length = start >= size ? 0 : (size - start < piece_size ? size - start : piece_size);
+		piece_largenumber(&piece, number + start, length);
+
+		if( !multiply_into_largenumber(evaluated, evaluated, &multiplying)
+		   || !add_into_largenumber(evaluated, evaluated, &piece)){
+			free_largenumber(evaluated);
+			evaluated = NULL;
+			return NULL;
+		}
+	}
+
+	return evaluated;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	divide_exact_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a large number in place by a small value that is known to divide it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being divided.
+ |				divisor,			The non zero value it is divided by.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void divide_exact_largenumber(large_number* number, int divisor){
+	if( divisor < 0){
+		divisor = -divisor;
+		number->sign = number->sign == POSITIVE ? NEGATIVE : POSITIVE;
+	}
+	divide_segment(number->segments, number->segments, number->size, divisor);
+	trim_largenumber(number);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	toom_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two segment arrays together using toom-cook's method, splitting
+ |				both into a given amount of pieces.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The longer array and its length.
+ |				two, size_two,		The shorter array and its length, more than half as
+ |									long as the longer one.
+ |				pieces,				The amount of pieces, three or four.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Each array is treated as a polynomial in B = MAXVALUE^piece_size with the
+ |				pieces as coefficients. The product polynomial is found at the points 0, 1,
+ |				-1, 2, -2 (and 3, -3 for four pieces), then interpolated with newton's
+ |				divided differences. Every division is exact, as the divided differences of
+ |				a polynomial with integer coefficients at integer points are integers.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int toom_segments(segment* result, const segment* one, size_t size_one,
+						 const segment* two, size_t size_two, int pieces){
+	static const int points[TOOM_MAX_POINTS] = { 0, 1, -1, 2, -2, 3, -3 };
+	large_number* values[TOOM_MAX_POINTS] = { NULL };
+	large_number* evaluated_one, *evaluated_two, *multiplied = NULL;
+	large_number multiplying;
+	segment multiplying_segments[3];
+	size_t piece_size = (size_one + pieces - 1) / pieces, total = size_one + size_two, offset;
+	int count = 2 * pieces - 1, i, j, success = 1;
+	int square = one == two && size_one == size_two;
+	largenumber_arena* previous = use_largenumber_arena(NULL);
+
+	///Both polynomials are evaluated at every point, and the values multiplied. A square
+	///only has the one polynomial to evaluate, and every value is squared.
+	for( i = 0; i < count && success; i++){
+		evaluated_one = toom_evaluate(one, size_one, pieces, piece_size, points[i]);
+		evaluated_two = square ? evaluated_one
+							   : toom_evaluate(two, size_two, pieces, piece_size, points[i]);
+		if( evaluated_one == NULL || evaluated_two == NULL
+		   || (values[i] = init_sized_largenumber(evaluated_one->size + evaluated_two->size)) == NULL
+		   || !multiply_into_largenumber(values[i], evaluated_one, evaluated_two)){
+			success = 0;
+		}
+		free_largenumber(evaluated_one);
+		if( !square){
+			free_largenumber(evaluated_two);
+		}
+	}
+
+	///The newton coefficients are found from the divided differences of the values.
+	for( j = 1; j < count && success; j++){
+		for( i = count - 1; i >= j && success; i--){
+			if( !sub_into_largenumber(values[i], values[i], values[i-1])){
+				success = 0;
+				break;
+			}
+			divide_exact_largenumber(values[i], points[i] - points[i-j]);
+		}
+	}
+
+	///The newton form is expanded into the coefficients of the product with horner's
+	///method. After each step values[j + t] holds the coefficient of x^t, so multiplying
+	///by (x - point) negates point times the next coefficient from every coefficient.
+	if( success && (multiplied = init_sized_largenumber(piece_size + 4)) == NULL){
+		success = 0;
+	}
+	for( j = count - 2; j >= 0 && success; j--){
+		value_largenumber(&multiplying, multiplying_segments, points[j]);
+		for( i = j; i < count - 1; i++){
+			if( !multiply_into_largenumber(multiplied, values[i+1], &multiplying)
+			   || !sub_into_largenumber(values[i], values[i], multiplied)){
+				success = 0;
+				break;
+			}
+		}
+	}
+
+	///The coefficients are added into the result at their offsets.
+	if( success){
+		memset(result, 0, total * sizeof(segment));
+		for( i = 0, offset = 0; i < count; i++, offset += piece_size){
+			if( values[i]->size == 1 && values[i]->segments[0] == 0){
+				continue;
+			}
+			add_segments(result + offset, result + offset, total - offset,
+						 values[i]->segments, values[i]->size);
+		}
+	}
+
+	free_largenumber(multiplied);
+	for( i = 0; i < count; i++){
+		free_largenumber(values[i]);
+	}
+	use_largenumber_arena(previous);
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_segments_blocks
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies a segment array by one at most half as long, by splitting the
+ |				longer one into blocks the size of the shorter one.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The longer array and its length.
+ |				two, size_two,		The shorter array and its length.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int multiply_segments_blocks(segment* result, const segment* one, size_t size_one,
+									const segment* two, size_t size_two){
+	segment* block;
+	size_t capacity = 2 * size_two, offset, length;
+
+	if( (block = alloc_segments(&capacity, NULL)) == NULL){
+		return 0;
+	}
+	if( !multiply_segments(result, one, size_two, two, size_two)){
+		release_segments(block, capacity, NULL);
+		return 0;
+	}
+	memset(result + 2 * size_two, 0, (size_one - size_two) * sizeof(segment));
+
+	///Each further block product is added into the result at the blocks offset.
+	for( offset = size_two; offset < size_one; offset += size_two){
+		length = size_one - offset < size_two ? size_one - offset : size_two;
+		if( !multiply_segments(block, one + offset, length, two, size_two)){
+			release_segments(block, capacity, NULL);
+			return 0;
+		}
+		add_segments(result + offset, result + offset, size_one + size_two - offset,
+					 block, length + size_two);
+	}
+	release_segments(block, capacity, NULL);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		ntt_prime
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	A prime the number theoretic transform is done under, with the values
+ |				needed for montgomery multiplication with R = 2^32.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		modulus,			The prime, which is k * 2^23 + 1 for some k.
+ |				generator,			A primitive root of the prime.
+ |				inverse,			-modulus^-1 mod 2^32.
+ |				r_squared,			2^64 mod modulus, used to convert into montgomery form.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+typedef struct ntt_prime{
+	unsigned int modulus;
+	unsigned int generator;
+	unsigned int inverse;
+	unsigned int r_squared;
+} ntt_prime;
+
+static const ntt_prime ntt_primes[NTT_PRIMES] = {
+	{ 998244353, 3, 998244351, 932051910 },
+	{ 167772161, 3, 167772159, 40265974 },
+	{ 469762049, 3, 469762047, 460175152 }
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	ntt_reduce
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Montgomery reduction of a value below modulus * 2^32.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value,				The value being reduced.
+ |				prime,				The prime it is reduced by.
+ |	@return:	value * 2^-32 mod the prime.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned int ntt_reduce(unsigned long long value, const ntt_prime* prime){
+	unsigned int multiple = (unsigned int) value * prime->inverse;
+
+	value = (value + (unsigned long long) multiple * prime->modulus) >> 32;
+	return (unsigned int) (value >= prime->modulus ? value - prime->modulus : value);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	ntt_multiply
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two values in montgomery form.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned int ntt_multiply(unsigned int one, unsigned int two, const ntt_prime* prime){
+	return ntt_reduce((unsigned long long) one * two, prime);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	ntt_power
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a value in montgomery form to a power.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned int ntt_power(unsigned int base, unsigned int exponent, const ntt_prime* prime){
+	unsigned int powered = ntt_reduce(prime->r_squared, prime);	//One in montgomery form.
+
+	for( ; exponent > 0; exponent >>= 1){
+		if( exponent & 1){
+			powered = ntt_multiply(powered, base, prime);
+		}
+		base = ntt_multiply(base, base, prime);
+	}
+	return powered;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	ntt_roots
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Fills a table with the powers of a primitive root of unity.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		roots,				Where length / 2 powers are written, in montgomery form.
+ |				length,				The order of the root, a power of two.
+ |				inverse,			Non zero if the powers of the inverse root are wanted.
+ |				prime,				The prime the root is under.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void ntt_roots(unsigned int* roots, size_t length, int inverse, const ntt_prime* prime){
+	unsigned int root, generator = ntt_multiply(prime->generator, prime->r_squared, prime);
+	size_t i;
+
+	root = ntt_power(generator, (unsigned int) ((prime->modulus - 1) / length), prime);
+	if( inverse){
+		root = ntt_power(root, (unsigned int) (length - 1), prime);
+	}
+	roots[0] = ntt_reduce(prime->r_squared, prime);
+	for( i = 1; i < length / 2; i++){
+		roots[i] = ntt_multiply(roots[i-1], root, prime);
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	ntt_forward
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Transforms values with decimation in frequency, leaving them in bit
+ |				reversed order.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		values, length,		The values in montgomery form and their amount.
+ |				roots,				The powers of the root of unity of order length.
+ |				prime,				The prime the transform is under.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void ntt_forward(unsigned int* values, size_t length, const unsigned int* roots,
+						const ntt_prime* prime){
+	unsigned int modulus = prime->modulus, high, low;
+	size_t half, step, block, i;
+
+	for( half = length / 2, step = 1; half > 0; half /= 2, step *= 2){
+		for( block = 0; block < length; block += 2 * half){
+			for( i = 0; i < half; i++){
+				low = values[block + i];
+				high = values[block + i + half];
+				values[block + i] = low + high >= modulus ? low + high - modulus : low + high;
+				values[block + i + half] = ntt_multiply(low + modulus - high, roots[i * step],
+														prime);
+			}
+		}
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	ntt_inverse
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Transforms bit reversed values back with decimation in time, leaving them
+ |				in order but not yet divided by the length.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		values, length,		The values in montgomery form and their amount.
+ |				roots,				The powers of the inverse root of unity of order length.
+ |				prime,				The prime the transform is under.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void ntt_inverse(unsigned int* values, size_t length, const unsigned int* roots,
+						const ntt_prime* prime){
+	unsigned int modulus = prime->modulus, high, low;
+	size_t half, step, block, i;
+
+	for( half = 1, step = length / 2; half < length; half *= 2, step /= 2){
+		for( block = 0; block < length; block += 2 * half){
+			for( i = 0; i < half; i++){
+				low = values[block + i];
+				high = ntt_multiply(values[block + i + half], roots[i * step], prime);
+				values[block + i] = low + high >= modulus ? low + high - modulus : low + high;
+				values[block + i + half] = low >= high ? low - high : low + modulus - high;
+			}
+		}
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	ntt_convolve
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the cyclic convolution of two segment arrays under one prime, or of
+ |				one array with itself when both are the same.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		convolved,			Where the length values of the convolution are written,
+ |									as plain residues.
+ |				working,			Length values of working space.
+ |				roots,				Length / 2 values of working space for the roots.
+ |				length,				The transform length, a power of two.
+ |				one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length.
+ |				prime,				The prime the convolution is under.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void ntt_convolve(unsigned int* convolved, unsigned int* working, unsigned int* roots,
+						 size_t length, const segment* one, size_t size_one,
+						 const segment* two, size_t size_two, const ntt_prime* prime){
+	unsigned int scale;
+	size_t i;
+
+	///Both arrays are put into montgomery form, padded with zeros to the length. A square
+	///only has the one array to transform.
+	for( i = 0; i < length; i++){
+		convolved[i] = i < size_one ? ntt_multiply(one[i] % prime->modulus, prime->r_squared, prime) : 0;
+	}
+	ntt_roots(roots, length, 0, prime);
+	ntt_forward(convolved, length, roots, prime);
+	if( one == two && size_one == size_two){
+		working = convolved;
+	}
+	else{
+		for( i = 0; i < length; i++){
+			working[i] = i < size_two ? ntt_multiply(two[i] % prime->modulus, prime->r_squared, prime) : 0;
+		}
+		ntt_forward(working, length, roots, prime);
+	}
+
+	for( i = 0; i < length; i++){
+		convolved[i] = ntt_multiply(convolved[i], working[i], prime);
+	}
+
+	///The inverse transform is scaled by the inverse of the length, which also takes the
+	///values out of montgomery form.
+	ntt_roots(roots, length, 1, prime);
+	ntt_inverse(convolved, length, roots, prime);
+	scale = ntt_power(ntt_multiply(length % prime->modulus, prime->r_squared, prime),
+					  prime->modulus - 2, prime);
+	scale = ntt_reduce(scale, prime);
+	for( i = 0; i < length; i++){
+		convolved[i] = ntt_multiply(convolved[i], scale, prime);
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	ntt_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two segment arrays together with number theoretic transforms
+ |				under three primes, recombined with the chinese remainder theorem.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length, with the two lengths
+ |									adding up to at most NTT_MAX_LENGTH.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Every value of the convolution is below size * MAXVALUE^2, which is less
+ |				than the product of the three primes, so the recombined value is exact.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int ntt_segments(segment* result, const segment* one, size_t size_one,
+						const segment* two, size_t size_two){
+	const ntt_prime* first = &ntt_primes[0], *second = &ntt_primes[1], *third = &ntt_primes[2];
+	unsigned int* convolved[NTT_PRIMES], *working, *roots;
+	unsigned long long first_second, low, high, carry = 0, value;
+	unsigned int inverse_first, inverse_first_second, residue_second, residue_third;
+	size_t length = 1, total = size_one + size_two, i;
+	int prime, success = 1;
+
+	while( length < total){
+		length *= 2;
+	}
+	working = malloc(length * sizeof(unsigned int));
+	roots = malloc(length / 2 * sizeof(unsigned int));
+	for( prime = 0; prime < NTT_PRIMES; prime++){
+		if( (convolved[prime] = malloc(length * sizeof(unsigned int))) == NULL){
+			success = 0;
+		}
+	}
+	if( working == NULL || roots == NULL){
+		success = 0;
+	}
+
+	if( success){
+		for( prime = 0; prime < NTT_PRIMES; prime++){
+			ntt_convolve(convolved[prime], working, roots, length, one, size_one,
+						 two, size_two, &ntt_primes[prime]);
+		}
+
+		///The inverses used by garner's method are found in montgomery form.
+		inverse_first = ntt_power(ntt_multiply(first->modulus % second->modulus,
+									second->r_squared, second), second->modulus - 2, second);
+		first_second = (unsigned long long) first->modulus * second->modulus;
+		inverse_first_second = ntt_power(ntt_multiply((unsigned int) (first_second % third->modulus),
+									third->r_squared, third), third->modulus - 2, third);
+
+		///Each value is rebuilt as r1 + p1*t2 + p1*p2*t3 and carried into the result, with
+		///the p1*p2*t3 part split around MAXVALUE so nothing overflows.
+		for( i = 0; i < total; i++){
+			residue_second = (convolved[1][i] + second->modulus - convolved[0][i] % second->modulus)
+							 % second->modulus;
+			residue_second = ntt_multiply(residue_second, inverse_first, second);
+			value = convolved[0][i] + (unsigned long long) first->modulus * residue_second;
+
+			residue_third = (unsigned int) ((convolved[2][i] + third->modulus
+							 - value % third->modulus) % third->modulus);
+			residue_third = ntt_multiply(residue_third, inverse_first_second, third);
+
+			low = value % MAXVALUE + (unsigned long long) residue_third * (first_second % MAXVALUE)
+				  + carry % MAXVALUE;
+			high = value / MAXVALUE + (unsigned long long) residue_third * (first_second / MAXVALUE)
+				   + carry / MAXVALUE;
+			result[i] = low % MAXVALUE;
+			carry = high + low / MAXVALUE;
+		}
+	}
+
+	free(working);
+	free(roots);
+	for( prime = 0; prime < NTT_PRIMES; prime++){
+		free(convolved[prime]);
+	}
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	square_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Squares a segment array, choosing the method based on its size in the same
+ |				way multiply_segments does.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the 2 * size segment square is written, must not
+ |									overlap the array.
+ |				number, size,		The array and its length.
+ |	@return:	1,					The squaring was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int square_segments(segment* result, const segment* number, size_t size){
+	segment* scratch;
+	size_t capacity;
+
+	if( size < karatsuba_threshold){
+		square_segments_basecase(result, number, size);
+		return 1;
+	}
+
+	///The transform and toom-cook methods notice when both arrays are the same.
+	if( size >= ntt_threshold && 2 * size <= NTT_MAX_LENGTH){
+		return ntt_segments(result, number, size, number, size);
+	}
+
+	if( size < toom3_threshold){
+		capacity = karatsuba_square_scratch(size);
+		if( (scratch = alloc_segments(&capacity, NULL)) == NULL){
+			return 0;
+		}
+		karatsuba_square(result, number, size, scratch);
+		release_segments(scratch, capacity, NULL);
+		return 1;
+	}
+
+	return toom_segments(result, number, size, number, size, size < toom4_threshold ? 3 : 4);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two segment arrays together, choosing the method based on the
+ |				size of the arrays.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size_one + size_two segment product is
+ |									written, must not overlap either array.
+ |				one, size_one,		The first array and its length.
+ |				two, size_two,		The second array and its length.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int multiply_segments(segment* result, const segment* one, size_t size_one,
+							 const segment* two, size_t size_two){
+	const segment* swapper;
+	segment* scratch;
+	size_t capacity, size_swap;
+
+	///The longer array is always made the first.
+	if( size_one < size_two){
+		swapper = one;
+		one = two;
+		two = swapper;
+		size_swap = size_one;
+		size_one = size_two;
+		size_two = size_swap;
+	}
+
+	if( one == two && size_one == size_two){
+		return square_segments(result, one, size_one);
+	}
+
+	if( size_two < karatsuba_threshold){
+		multiply_segments_basecase(result, one, size_one, two, size_two);
+		return 1;
+	}
+
+	if( size_two >= ntt_threshold && size_one + size_two <= NTT_MAX_LENGTH){
+		return ntt_segments(result, one, size_one, two, size_two);
+	}
+
+	if( size_two < toom3_threshold){
+		capacity = karatsuba_scratch(size_one, size_two);
+		if( (scratch = alloc_segments(&capacity, NULL)) == NULL){
+			return 0;
+		}
+		karatsuba_segments(result, one, size_one, two, size_two, scratch);
+		release_segments(scratch, capacity, NULL);
+		return 1;
+	}
+
+	///Toom-cook is only used on arrays of similar length, a much longer array is split.
+	if( 2 * size_two <= size_one){
+		return multiply_segments_blocks(result, one, size_one, two, size_two);
+	}
+	return toom_segments(result, one, size_one, two, size_two,
+						 size_two < toom4_threshold ? 3 : 4);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_karatsuba_threshold
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments both numbers need before multiplication uses
+ |				karatsuba's method instead of the schoolbook method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		threshold			The amount of segments, at least two.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void set_karatsuba_threshold(size_t threshold){
+	karatsuba_threshold = threshold < 2 ? 2 : threshold;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_toom_thresholds
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments both numbers need before multiplication uses
+ |				toom-3 and toom-4 instead of karatsuba's method. They are only reached
+ |				for products too long for the number theoretic transforms.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		toom3,				The amount of segments toom-3 is used from.
+ |				toom4,				The amount of segments toom-4 is used from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void set_toom_thresholds(size_t toom3, size_t toom4){
+	toom3_threshold = toom3 < 9 ? 9 : toom3;
+	toom4_threshold = toom4 < 16 ? 16 : toom4;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_ntt_threshold
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments both numbers need before multiplication uses
+ |				number theoretic transforms instead of karatsuba's method. Products too
+ |				long for the transforms still use karatsuba's method or toom-cook.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		threshold			The amount of segments, at least two.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void set_ntt_threshold(size_t threshold){
+	ntt_threshold = threshold < 2 ? 2 : threshold;
+}
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	DIVISION ALGORITHMS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+#define DIVIDE_THRESHOLD	60				//Default segments before recursive division is used.
+
+static size_t divide_threshold = DIVIDE_THRESHOLD;
+
+static int divide_segments_recursive(segment* quotient, segment* high, segment* number,
+									 const segment* divisor, size_t size, segment* scratch);
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divide_segments_basecase
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a normalised segment array by another using knuth's algorithm D.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the size - divisor_size segment quotient is
+ |									written.
+ |				number, size,		The array being divided and its length. It is replaced
+ |									by the remainder in its lowest divisor_size segments.
+ |				divisor,			The divisor and its length, with its most significant
+ |				divisor_size,		segment at least MAXVALUE / 2.
+ |	@return:	The quotient segment above the written quotient, zero or one.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The most significant divisor_size segments of the number must be less than
+ |				twice the divisor.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment divide_segments_basecase(segment* quotient, segment* number, size_t size,
+										const segment* divisor, size_t divisor_size){
+	unsigned long long estimate, estimate_remainder, product, carry, negating;
+	segment divisor_top = divisor[divisor_size - 1], high = 0;
+	segment divisor_next, borrow;
+	size_t i, j;
+
+	///The top of the number is brought below the divisor, so every further quotient
+	///segment fits in a single segment.
+	if( compare_segments(number + size - divisor_size,
+						 trimmed_size(number + size - divisor_size, divisor_size),
+						 divisor, divisor_size) >= 0){
+		sub_segments(number + size - divisor_size, number + size - divisor_size,
+					 divisor_size, divisor, divisor_size);
+		high = 1;
+	}
+
+	if( divisor_size == 1){
+		estimate_remainder = number[size - 1];
+		for( j = size - 1; j > 0; j--){
+			estimate_remainder = estimate_remainder * MAXVALUE + number[j - 1];
+			quotient[j - 1] = (segment) (estimate_remainder / divisor_top);
+			estimate_remainder %= divisor_top;
+			number[j] = 0;
+		}
+		number[0] = (segment) estimate_remainder;
+		return high;
+	}
+	divisor_next = divisor[divisor_size - 2];
+
+	///Each quotient segment is estimated from the top two segments of the remainder and
+	///the top segment of the divisor, corrected using the next divisor segment, then the
+	///divisor times the estimate is negated from the remainder.
+	for( j = size - divisor_size; j > 0; j--){
+		estimate = (unsigned long long) number[j + divisor_size - 1] * MAXVALUE
+				   + number[j + divisor_size - 2];
+		estimate_remainder = estimate % divisor_top;
+		estimate /= divisor_top;
+		while( estimate >= MAXVALUE
+			  || estimate * divisor_next
+				 > estimate_remainder * MAXVALUE + number[j + divisor_size - 3]){
+			estimate--;
+			if( (estimate_remainder += divisor_top) >= MAXVALUE){
+				break;
+			}
+		}
+
+		carry = 0;
+		borrow = 0;
+		for( i = 0; i < divisor_size; i++){
+			product = estimate * divisor[i] + carry;
+			carry = product / MAXVALUE;
+			negating = product % MAXVALUE + borrow;
+			if( number[j - 1 + i] >= negating){
+				number[j - 1 + i] -= (segment) negating;
+				borrow = 0;
+			}
+			else{
+				number[j - 1 + i] = (segment) (number[j - 1 + i] + MAXVALUE - negating);
+				borrow = 1;
+			}
+		}
+		negating = carry + borrow;
+
+		///The estimate can still be one too large, in which case the divisor is added back.
+		if( number[j - 1 + divisor_size] < negating){
+			estimate--;
+			add_segments(number + j - 1, number + j - 1, divisor_size, divisor, divisor_size);
+		}
+		number[j - 1 + divisor_size] = 0;
+		quotient[j - 1] = (segment) estimate;
+	}
+
+	return high;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divide_segments_block
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds block segments of a quotient by dividing the top of a number by the
+ |				top block segments of the divisor, then correcting the remainder with
+ |				the rest of the divisor.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the block segment quotient is written.
+ |				high,				Where the quotient segment above it is written.
+ |				number,				The size + block segments being divided, replaced by the
+ |									remainder in its lowest size segments.
+ |				divisor, size,		The normalised divisor and its length.
+ |				block,				The amount of quotient segments, at most size.
+ |				scratch,			Space for size segments.
+ |	@return:	1,					The division was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int divide_segments_block(segment* quotient, segment* high, segment* number,
+								 const segment* divisor, size_t size, size_t block,
+								 segment* scratch){
+	segment borrow;
+	size_t i, rest = size - block;
+
+	if( !divide_segments_recursive(quotient, high, number + rest, divisor + rest, block,
+								   scratch)){
+		return 0;
+	}
+	if( rest == 0){
+		return 1;
+	}
+
+	///The quotient only saw the top of the divisor, so the rest of the divisor times the
+	///quotient is negated, and the divisor added back while the remainder is negative.
+	if( !multiply_segments(scratch, quotient, block, divisor, rest)){
+		return 0;
+	}
+	borrow = sub_segments(number, number, size, scratch, size);
+	if( *high){
+		borrow += sub_segments(number + block, number + block, rest, divisor, rest);
+	}
+	while( borrow){
+		for( i = 0; i < block && quotient[i] == 0; i++){
+			quotient[i] = MAXVALUE - 1;
+		}
+		if( i < block){
+			quotient[i]--;
+		}
+		else{
+			(*high)--;
+		}
+		borrow -= add_segments(number, number, size, divisor, size);
+	}
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divide_segments_recursive
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides 2 * size segments by a size segment divisor using burnikel and
+ |				ziegler's method, which finds each half of the quotient recursively.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the size segment quotient is written.
+ |				high,				Where the quotient segment above it is written.
+ |				number,				The 2 * size segments being divided, replaced by the
+ |									remainder in its lowest size segments.
+ |				divisor, size,		The normalised divisor and its length.
+ |				scratch,			Space for size segments.
+ |	@return:	1,					The division was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The top size segments of the number must be less than twice the divisor.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int divide_segments_recursive(segment* quotient, segment* high, segment* number,
+									 const segment* divisor, size_t size, segment* scratch){
+	segment low_high;
+	size_t low = size / 2;
+
+	if( size < divide_threshold){
+		*high = divide_segments_basecase(quotient, number, 2 * size, divisor, size);
+		return 1;
+	}
+
+	///The upper half of the quotient leaves a size segment remainder, which the lower half
+	///is then found from. The lower half never overflows, as that remainder is below the
+	///divisor.
+	if( !divide_segments_block(quotient + low, high, number + low, divisor, size,
+							   size - low, scratch)){
+		return 0;
+	}
+	return divide_segments_block(quotient, &low_high, number, divisor, size, low, scratch);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divide_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a segment array by another, finding the quotient and remainder.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the size - divisor_size + 1 segment quotient is
+ |									written.
+ |				remainder,			Where the divisor_size segment remainder is written.
+ |				number, size,		The array being divided and its length, at least as
+ |									long as the divisor.
+ |				divisor,			The divisor and its length, with its most significant
+ |				divisor_size,		segment not zero.
+ |	@return:	1,					The division was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Long divisors are divided a divisor length of quotient at a time with the
+ |				recursive method, so the cost stays close to that of multiplication.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int divide_segments(segment* quotient, segment* remainder, const segment* number,
+						   size_t size, const segment* divisor, size_t divisor_size){
+	segment* normal_number, *normal_divisor, *scratch;
+	segment scale, high;
+	size_t capacity = size + 1 + 2 * divisor_size, quotient_size = size - divisor_size + 1;
+	size_t block, done;
+
+	if( divisor_size == 1){
+		remainder[0] = divide_segment(quotient, number, size, divisor[0]);
+		return 1;
+	}
+
+	///Both arrays are scaled so the top divisor segment is at least half of MAXVALUE,
+	///which keeps every quotient estimate within two of the true segment.
+	if( (normal_number = alloc_segments(&capacity, NULL)) == NULL){
+		return 0;
+	}
+	normal_divisor = normal_number + size + 1;
+	scratch = normal_divisor + divisor_size;
+	scale = (segment) (MAXVALUE / ((unsigned long long) divisor[divisor_size - 1] + 1));
+	normal_number[size] = multiply_segment(normal_number, number, size, scale);
+	multiply_segment(normal_divisor, divisor, divisor_size, scale);
+
+	if( divisor_size < divide_threshold){
+		divide_segments_basecase(quotient, normal_number, size + 1, normal_divisor,
+								 divisor_size);
+	}
+	else{
+		///The quotient is found from the most significant end, the first block taking
+		///whatever is left over from whole divisor lengths.
+		for( done = 0; done < quotient_size; done += block){
+			block = (quotient_size - done) % divisor_size;
+			if( block == 0 || done > 0){
+				block = divisor_size;
+			}
+			if( !divide_segments_block(quotient + quotient_size - done - block, &high,
+									   normal_number + quotient_size - done - block,
+									   normal_divisor, divisor_size, block, scratch)){
+				release_segments(normal_number, capacity, NULL);
+				return 0;
+			}
+		}
+	}
+
+	///The remainder is scaled back down.
+	divide_segment(remainder, normal_number, divisor_size, scale);
+	release_segments(normal_number, capacity, NULL);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_division_threshold
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments a divisor needs before division uses burnikel
+ |				and ziegler's recursive method instead of knuth's algorithm D.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		threshold			The amount of segments, at least two.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void set_division_threshold(size_t threshold){
+	divide_threshold = threshold < 2 ? 2 : threshold;
+}
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	MEMORY AND INPUT/OUTPUT FUNCTIONS FOR LARGE NUMBERS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	release_storage
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gives the segments of a large number back to where they were allocated
+ |				from, unless they are held inside the number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number				The number whose storage is released.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void release_storage(large_number* number){
+	if( number->segments != number->inline_segments){
+		release_segments(number->segments, number->capacity, number->arena);
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_sized_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Initialise function for a positive large number with a given amount of
+ |				segments, all set to zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		size				The amount of segments the number will hold.
+ |	@return:	making_largenumber	The initialisation was a success.
+ |				NULL,				Allocation of memory failed, intialisation unsuccessful.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* init_sized_largenumber(size_t size){
+	large_number* making_largenumber;
+	size_t capacity = size < MIN_CAPACITY ? MIN_CAPACITY : size;
+
+	///Allocates memory for the entire number, then allocates memory for its segments unless
+	///they fit inside it.
+	if( (making_largenumber = alloc_largenumber()) == NULL){
+		return NULL;						//Allocation failed, return error value
+	}
+	if( size <= LARGENUMBER_INLINE){
+		making_largenumber->segments = making_largenumber->inline_segments;
+		capacity = LARGENUMBER_INLINE;
+	}
+	else if( (making_largenumber->segments = alloc_segments(&capacity,
+															 making_largenumber->arena)) == NULL){
+		release_largenumber(making_largenumber);
+		making_largenumber = NULL;
+		return NULL;
+	}
+	memset(making_largenumber->segments, 0, capacity * sizeof(segment));
+	making_largenumber->size = size > 0 ? size : 1;
+	making_largenumber->capacity = capacity;
+	making_largenumber->sign = POSITIVE;
+	making_largenumber->decimal_position = 0;
+	making_largenumber->max_dec_places = 0;	//No decimals are allowed by default.
+
+	return making_largenumber;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	trim_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Removes all leading zero segments from a large number, and makes sure a zero
+ |				value is positive.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number				The large number being trimmed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void trim_largenumber(large_number* number){
+	while( number->size > 1 && number->segments[number->size - 1] == 0){
+		number->size--;
+	}
+	if( number->size == 1 && number->segments[0] == 0){
+		number->sign = POSITIVE;
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	resize_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Changes the amount of segments used by a large number, growing its storage
+ |				if needed. Any segments added are set to zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number				The large number being resized.
+ |				size				The amount of segments it will use.
+ |	@return:	1,					The resize was a success.
+ |				0,					Allocation of memory failed, the number is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int resize_largenumber(large_number* number, size_t size){
+	segment* grown;
+	size_t capacity;
+
+	if( size == 0){
+		size = 1;
+	}
+	///The storage is doubled until it can hold the size, so repeated growth is cheap.
+	if( size > number->capacity){
+		for( capacity = number->capacity * 2; capacity < size; capacity *= 2);
+		if( (grown = alloc_segments(&capacity, number->arena)) == NULL){
+			return 0;						//Allocation failed, return error value.
+		}
+		memcpy(grown, number->segments, number->size * sizeof(segment));
+		release_storage(number);
+		number->segments = grown;
+		number->capacity = capacity;
+	}
+	if( size > number->size){
+		memset(number->segments + number->size, 0, (size - number->size) * sizeof(segment));
+	}
+	number->size = size;
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	free_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	To free all allocated memory used in a large number. The memory is given
+ |				back to the pool, or left for the arena it came from to release.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		deleting_largenumber	The large number which will be deleted.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void free_largenumber(large_number* deleting_largenumber){
+	if( deleting_largenumber == NULL){
+		return;
+	}
+	release_storage(deleting_largenumber);
+	deleting_largenumber->segments = NULL;
+	//Memory allocated for large number itself is freed and set to null.
+	release_largenumber(deleting_largenumber);
+	deleting_largenumber = NULL;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_largenumber
+ -- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Initialise function for a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value_number		The value the number will be set to.
+ |	@return:	largenumber_making	The initialisation was a success.
+ |				NULL,				Allocation of memory failed, intialisation unsuccessful.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* init_largenumber(long long value_number){
+	large_number* making_largenumber;
+	unsigned long long magnitude;
+	size_t size = 0;
+
+	///Allocates memory for the entire number, with enough segments for any long long.
+	if( (making_largenumber = init_sized_largenumber(MIN_CAPACITY)) == NULL){
+		return NULL;						//Allocation failed, return error value
+	}
+
+	if( value_number >= 0){
+		making_largenumber->sign = POSITIVE;
+		magnitude = (unsigned long long) value_number;
+	}
+	else{
+		making_largenumber->sign = NEGATIVE;
+		magnitude = 0ULL - (unsigned long long) value_number;
+	}
+
+	do{
+		making_largenumber->segments[size++] = magnitude % MAXVALUE;
+	} while( (magnitude /= MAXVALUE) > 0);
+	making_largenumber->size = size;
+
+	return making_largenumber;
+}
+
+
+static const char digit_pairs[] =			//Every two digit pair, for writing digits.
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+#if defined(LARGENUMBER_BINARY)
+#define PARSE_THRESHOLD		32				//Digits converted without splitting them.
+#define DECIMAL_LEVELS		64				//Most powers of DECIMAL_BASE ever cached.
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	decimal_power
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds DECIMAL_BASE to the power of 2^level, caching every power found so
+ |				each is only squared once per conversion.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		powers,				The cache, DECIMAL_LEVELS numbers that start as NULL.
+ |				level,				The power of two the power is raised to.
+ |	@return:	power,				The power, owned by the cache.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* decimal_power(large_number** powers, int level){
+	large_number* root;
+
+	if( powers[level] == NULL){
+		if( level == 0){
+			powers[level] = init_largenumber(DECIMAL_BASE);
+		}
+		else if( (root = decimal_power(powers, level - 1)) != NULL){
+			powers[level] = multiply_two_largenumbers(root, root);
+		}
+	}
+	return powers[level];
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	decimal_split
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Converts a number into a given amount of DECIMAL_BASE digits, by dividing
+ |				it by a cached power of DECIMAL_BASE and converting each part.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		decimal, size,		Where the digits are written and their amount, which
+ |									must be enough to hold the number.
+ |				number,				The positive number being converted.
+ |				powers,				The cache of powers used by decimal_power.
+ |	@return:	1,					The conversion was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int decimal_split(segment* decimal, size_t size, large_number* number,
+						 large_number** powers){
+	large_number* quotient, *remainder, *power;
+	size_t half = 1, i;
+	int level = 0, success;
+
+	///Short numbers have a digit divided off at a time.
+	if( size <= PARSE_THRESHOLD){
+		if( (quotient = copy_largenumber(number)) == NULL){
+			return 0;
+		}
+		for( i = 0; i < size; i++){
+			decimal[i] = divide_segment(quotient->segments, quotient->segments, quotient->size,
+										DECIMAL_BASE);
+			trim_largenumber(quotient);
+		}
+		free_largenumber(quotient);
+		return 1;
+	}
+
+	///The lower part is the largest power of two digits, so its power can be cached.
+	while( half * 2 < size){
+		half *= 2;
+		level++;
+	}
+	if( (power = decimal_power(powers, level)) == NULL){
+		return 0;
+	}
+	quotient = init_largenumber(0);
+	remainder = init_largenumber(0);
+	success = quotient != NULL && remainder != NULL
+			  && divmod_largenumber(quotient, remainder, number, power) == 1
+			  && decimal_split(decimal, half, remainder, powers)
+			  && decimal_split(decimal + half, size - half, quotient, powers);
+	free_largenumber(quotient);
+	free_largenumber(remainder);
+
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	decimal_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Converts a large number into DECIMAL_BASE digits for output.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being converted.
+ |				decimal_size,		Where the amount of digits found is written.
+ |				capacity,			Where the capacity of the returned array is written.
+ |	@return:	decimal,			The digits, least significant first, to be released to
+ |									the segment pool.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment* decimal_segments(large_number* number, size_t* decimal_size,
+								 size_t* capacity){
+	large_number* powers[DECIMAL_LEVELS] = {NULL};
+	large_number magnitude;
+	largenumber_arena* previous;
+	segment* decimal;
+	int level, success;
+
+	///Every segment holds less than 32 / 29.8 DECIMAL_BASE digits.
+	*capacity = number->size + number->size / 8 + 1;
+	if( (decimal = alloc_segments(capacity, NULL)) == NULL){
+		return NULL;
+	}
+	///The powers and parts are made from the pool, even when an arena is in use.
+	previous = use_largenumber_arena(NULL);
+	success = decimal_split(decimal, number->size + number->size / 8 + 1,
+							piece_largenumber(&magnitude, number->segments, number->size),
+							powers);
+	for( level = 0; level < DECIMAL_LEVELS; level++){
+		free_largenumber(powers[level]);
+	}
+	use_largenumber_arena(previous);
+	if( !success){
+		release_segments(decimal, *capacity, NULL);
+		return NULL;
+	}
+	*decimal_size = trimmed_size(decimal, number->size + number->size / 8 + 1);
+	if( *decimal_size == 0){
+		*decimal_size = 1;
+	}
+
+	return decimal;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	binary_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Converts DECIMAL_BASE digits into a large number, by converting each half
+ |				of the digits and joining them with a cached power of DECIMAL_BASE.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		decimal, size,		The digits, least significant first, and their amount.
+ |				powers,				The cache of powers used by decimal_power.
+ |	@return:	converted,			The converted number.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		With the fast multiplication methods, the conversion takes a log factor
+ |				more than a multiplication instead of quadratic time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* binary_segments(const segment* decimal, size_t size,
+									 large_number** powers){
+	large_number* converted, *low, *power;
+	unsigned long long value_adding;
+	size_t half = 1, i, j;
+	int level = 0;
+
+	///Short runs of digits are converted using horner's method, each digit from the most
+	///significant being added after the value so far is multiplied by DECIMAL_BASE.
+	if( size <= PARSE_THRESHOLD){
+		if( (converted = init_sized_largenumber(size)) == NULL){
+			return NULL;
+		}
+		converted->size = 0;
+		for( i = size; i > 0; i--){
+			value_adding = decimal[i-1];
+			for( j = 0; j < converted->size; j++){
+				value_adding += (unsigned long long) converted->segments[j] * DECIMAL_BASE;
+				converted->segments[j] = value_adding % MAXVALUE;
+				value_adding /= MAXVALUE;
+			}
+			if( value_adding > 0){
+				converted->segments[converted->size++] = (segment) value_adding;
+			}
+		}
+		if( converted->size == 0){
+			converted->segments[converted->size++] = 0;
+		}
+		return converted;
+	}
+
+	///The lower half is the largest power of two digits, so its power can be cached.
+	while( half * 2 < size){
+		half *= 2;
+		level++;
+	}
+	if( (power = decimal_power(powers, level)) == NULL){
+		return NULL;
+	}
+	if( (low = binary_segments(decimal, half, powers)) == NULL){
+		return NULL;
+	}
+	if( (converted = binary_segments(decimal + half, size - half, powers)) == NULL
+	   || !multiply_into_largenumber(converted, converted, power)
+	   || !add_into_largenumber(converted, converted, low)){
+		free_largenumber(converted);
+		free_largenumber(low);
+		return NULL;
+	}
+	free_largenumber(low);
+
+	return converted;
+}
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	decimal_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gets the DECIMAL_BASE digits of a large number, converting them only if
+ |				segments are not already held in that base.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number whose digits are wanted.
+ |				decimal_size,		Where the amount of digits is written.
+ |				capacity,			Where the capacity of a converted array is written, to
+ |									be released to the segment pool, or zero if the digits
+ |									are the numbers own segments.
+ |	@return:	decimal,			The digits, least significant first.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static const segment* decimal_largenumber(large_number* number, size_t* decimal_size,
+										  size_t* capacity){
+#if defined(LARGENUMBER_BINARY)
+	return decimal_segments(number, decimal_size, capacity);
+#else
+	*decimal_size = number->size;
+	*capacity = 0;
+	return number->segments;
+#endif
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	render_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes the characters of a large number from its DECIMAL_BASE digits, or
+ |				only counts them.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being written.
+ |				decimal, size,		Its DECIMAL_BASE digits and their amount.
+ |				buffer,				Where the characters are written, or NULL to only count
+ |									them. No null character is added.
+ |	@return:	The amount of characters the number takes.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Digits are written two at a time from a table, rather than one at a time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t render_largenumber(large_number* number, const segment* decimal, size_t size,
+								 char* buffer){
+	char top[SEGMENT_DIGITS], *writing;
+	size_t digits, top_digits, length, places, i;
+	segment value;
+	int pair;
+
+	///The most significant digit is written without its leading zeros, so its length is
+	///found first.
+	for( top_digits = 1, value = decimal[size - 1]; value >= 10; value /= 10){
+		top_digits++;
+	}
+	digits = (size - 1) * SEGMENT_DIGITS + top_digits;
+	places = number->decimal_position > 0 ? (size_t) number->decimal_position : 0;
+
+	length = digits + (number->sign == NEGATIVE);
+	if( places >= digits){
+		length += 2 + places - digits;		//Decimal places are led by "0." and zeros.
+	}
+	else if( places > 0){
+		length++;
+	}
+	if( buffer == NULL){
+		return length;
+	}
+
+	writing = buffer;
+	if( number->sign == NEGATIVE){
+		*writing++ = '-';
+	}
+	if( places >= digits){
+		*writing++ = '0';
+		*writing++ = '.';
+		memset(writing, '0', places - digits);
+		writing += places - digits;
+	}
+
+	///Every digit from the most significant is written as nine characters, four pairs from
+	///the table and a single digit, then the leading zeros of the first are skipped.
+	for( i = size; i > 0; i--){
+		value = decimal[i-1];
+		for( pair = SEGMENT_DIGITS - 2; pair >= 0; pair -= 2){
+			memcpy(top + pair, digit_pairs + 2 * (value % 100), 2);
+			value /= 100;
+		}
+		top[0] = (char) ('0' + value);
+		if( i == size){
+			memcpy(writing, top + SEGMENT_DIGITS - top_digits, top_digits);
+			writing += top_digits;
+		}
+		else{
+			memcpy(writing, top, SEGMENT_DIGITS);
+			writing += SEGMENT_DIGITS;
+		}
+	}
+
+	///The decimal point is placed by moving the decimal places along one character.
+	if( places > 0 && places < digits){
+		memmove(writing - places + 1, writing - places, places);
+		writing[-(long) places] = '.';
+	}
+
+	return length;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	largenumber_to_string
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes the base ten characters of a large number into a buffer.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being written.
+ |				buffer,				Where the characters and a null character are written,
+ |									may be NULL to only find the length.
+ |				buffer_size,		The amount of characters the buffer can hold.
+ |	@return:	length,				The amount of characters the number takes, not counting
+ |									the null character. Nothing is written if the buffer
+ |									can not hold them all.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+size_t largenumber_to_string(large_number* number, char* buffer, size_t buffer_size){
+	const segment* decimal;
+	size_t decimal_size, capacity, length;
+
+	if( (decimal = decimal_largenumber(number, &decimal_size, &capacity)) == NULL){
+		return 0;
+	}
+	length = render_largenumber(number, decimal, decimal_size, NULL);
+	if( buffer != NULL && length < buffer_size){
+		render_largenumber(number, decimal, decimal_size, buffer);
+		buffer[length] = '\0';
+	}
+	if( capacity > 0){
+		release_segments((segment*) decimal, capacity, NULL);
+	}
+
+	return length;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	largenumber_to_new_string
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes the base ten characters of a large number into a new buffer, so
+ |				the number is converted only once whatever its length.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being written.
+ |				length,				Where the amount of characters is written, not counting
+ |									the null character, or NULL if it is not needed.
+ |	@return:	characters,			The characters and a null character, to be released
+ |									with free.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+char* largenumber_to_new_string(large_number* number, size_t* length){
+	const segment* decimal;
+	char* characters;						//Return value.
+	size_t decimal_size, capacity, written;
+
+	if( (decimal = decimal_largenumber(number, &decimal_size, &capacity)) == NULL){
+		return NULL;
+	}
+	written = render_largenumber(number, decimal, decimal_size, NULL);
+	if( (characters = malloc(written + 1)) != NULL){
+		render_largenumber(number, decimal, decimal_size, characters);
+		characters[written] = '\0';
+		if( length != NULL){
+			*length = written;
+		}
+	}
+	if( capacity > 0){
+		release_segments((segment*) decimal, capacity, NULL);
+	}
+
+	return characters;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	largenumber_write
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes the base ten characters of a large number to a stream, with a
+ |				single write of one buffer.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		stream,				Where the number is written.
+ |				number,				The number being written.
+ |	@return:	1,					The number was written.
+ |				0,					An error occured whilst allocating or writing.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int largenumber_write(FILE* stream, large_number* number){
+	const segment* decimal;
+	char* buffer;
+	size_t decimal_size, capacity, length;
+	int success = 0;
+
+	if( (decimal = decimal_largenumber(number, &decimal_size, &capacity)) == NULL){
+		return 0;
+	}
+	length = render_largenumber(number, decimal, decimal_size, NULL);
+	if( (buffer = malloc(length)) != NULL){
+		render_largenumber(number, decimal, decimal_size, buffer);
+		success = fwrite(buffer, 1, length, stream) == length;
+		free(buffer);
+	}
+	if( capacity > 0){
+		release_segments((segment*) decimal, capacity, NULL);
+	}
+
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	fprint_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Initialise print the contents of a large number to a stream in base ten.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		toprint_number,		The large number to be displayed to the given stream.
+ |				stream,				Where the number will be displayed to.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void fprint_largenumber(FILE* stream, large_number* toprint_number){
+	fputc('\n', stream);
+	largenumber_write(stream, toprint_number);
+	fputc('\n', stream);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	print_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Initialise print the contents of a large number to screen in base ten,
+ |				shorthand for the fprint_largenumber function.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		toprint_number		The large number to be displayed to the given stream.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void print_largenumber(large_number* toprint_number){
+	fprint_largenumber(stdout, toprint_number);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	copy_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Produces a new large number holding the same value as another.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		tocopy			The number whos values will be copied into another number.
+ |	@return:	copied,			The copied number.
+ |				NULL,			An error had occured.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* copy_largenumber(large_number* tocopy){
+	large_number* copied;
+
+	if( (copied = init_sized_largenumber(tocopy->size)) == NULL){
+		return NULL;
+	}
+	///All the segments are copied in one block.
+	memcpy(copied->segments, tocopy->segments, tocopy->size * sizeof(segment));
+	copied->sign = tocopy->sign;
+	copied->decimal_position = tocopy->decimal_position;
+	copied->max_dec_places = tocopy->max_dec_places;
+
+	return copied;
+}
+
+enum{
+	SCAN_LEADING,							//Whitespace before the number.
+	SCAN_SIGNED,							//A sign has been read.
+	SCAN_WHOLE,								//Digits before the decimal point.
+	SCAN_FRACTION,							//Digits after the decimal point.
+	SCAN_ENDED,								//A character not part of the number was found.
+	SCAN_FAILED								//Allocation failed.
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	next_scan_state
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds which part of a number is being read after its next character.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		state,				The part being read before the character.
+ |				character,			The character read.
+ |	@return:	The part being read after it, SCAN_ENDED if the character is not part of
+ |				the number. A sign gives SCAN_SIGNED, and a digit SCAN_WHOLE or
+ |				SCAN_FRACTION.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int next_scan_state(int state, int character){
+	if( state >= SCAN_ENDED){
+		return SCAN_ENDED;
+	}
+	if( character >= '0' && character <= '9'){
+		return state < SCAN_WHOLE ? SCAN_WHOLE : state;
+	}
+
+	switch( state){
+	case SCAN_LEADING:
+		if( character == ' ' || (character >= '\t' && character <= '\r')){
+			return SCAN_LEADING;
+		}
+		if( character == '-' || character == '+'){
+			return SCAN_SIGNED;
+		}
+		//Falls through - a number may start with its decimal point.
+	case SCAN_SIGNED:
+	case SCAN_WHOLE:
+		if( character == '.'){
+			return SCAN_FRACTION;
+		}
+		break;
+	}
+	return SCAN_ENDED;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	stolargenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Converts the character representation of a number into a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number_string		The character representation of the large number.
+ |	@return:	number,				The characters converted into a large number.
+ |				NULL,				The characters are not a number, or an error occured
+ |									whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Leading whitespace and a sign are skipped, and the digits after a decimal
+ |				point set its decimal position. Any other character, or a string without
+ |				digits, is not a number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* stolargenumber(char* number_string){
+	large_number* number;					//Return value.
+	const char* reading;
+	size_t digits = 0, index = 0;
+	segment converting = 0;
+	unsigned int sigfig = 1;
+	int state = SCAN_LEADING, decimal_places = 0;
+	char sign = POSITIVE;
+	largenumber_arena* previous = current_arena;
+#if defined(LARGENUMBER_BINARY)
+	large_number* powers[DECIMAL_LEVELS] = {NULL};
+	large_number* converted;
+	int level;
+#endif
+
+	///The characters are read once to count the digits, and find the sign and point. They
+	///follow the same rules as a scan, so anything that is not a number gives NULL.
+	for( reading = number_string; *reading != '\0'; reading++){
+		if( (state = next_scan_state(state, *reading)) == SCAN_ENDED){
+			return NULL;
+		}
+		if( *reading >= '0' && *reading <= '9'){
+			digits++;
+			decimal_places += state == SCAN_FRACTION;
+		}
+		else if( *reading == '-'){
+			sign = NEGATIVE;
+		}
+	}
+	if( digits == 0){
+		return NULL;
+	}
+
+#if defined(LARGENUMBER_BINARY)
+	///The base ten digits and their conversion are held in numbers from the pool.
+	use_largenumber_arena(NULL);
+#endif
+	if( (number = init_sized_largenumber(digits / SEGMENT_DIGITS + 1)) == NULL){
+		return restore_arena(NULL, previous);	//Allocation failed, return error value.
+	}
+
+	///Goes through all the characters from the end. If they are a number value, they
+	///are added to the current digit, which is stored once it holds nine digits.
+	while( reading != number_string){
+		reading--;
+		if( *reading >= '0' && *reading <= '9'){
+			converting += (segment) (*reading - '0') * sigfig;
+			sigfig *= 10;
+			if( sigfig == DECIMAL_BASE){
+				number->segments[index++] = converting;
+				converting = 0;
+				sigfig = 1;
+			}
+		}
+	}
+
+	///Under the case that a partial number is held after all characters are read, it is
+	///stored as the most significant digit.
+	if( sigfig != 1){
+		number->segments[index++] = converting;
+	}
+	number->size = index > 0 ? index : 1;
+
+#if defined(LARGENUMBER_BINARY)
+	///The base ten digits are converted into segments, split in half recursively.
+	converted = binary_segments(number->segments, number->size, powers);
+	for( level = 0; level < DECIMAL_LEVELS; level++){
+		free_largenumber(powers[level]);
+	}
+	free_largenumber(number);
+	if( (number = converted) == NULL){
+		return restore_arena(NULL, previous);
+	}
+#endif
+	number->sign = sign;
+	number->decimal_position = decimal_places;
+	trim_largenumber(number);
+
+	return restore_arena(number, previous);
+}
+
+#define SCAN_CHUNK		4096			//Characters read from a source at a time.
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		largenumber_scan
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The state of a number being read a part at a time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		number,				Every full DECIMAL_BASE digit read so far, in the order
+ |									they were read, so most significant first.
+ |				digits,				The amount of full digits held by the number.
+ |				converting,			The digit being read, and how many characters it holds.
+ |				converting_size,
+ |				state,				Which part of the number is being read.
+ |				sign,				POSITIVE, or NEGATIVE if a minus sign was read.
+ |				decimal_places,		The amount of digits read after the decimal point.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+struct largenumber_scan{
+	large_number* number;
+	size_t digits;
+	segment converting;
+	int converting_size;
+	int state;
+	char sign;
+	int decimal_places;
+};
+
+static const segment powers_of_ten[SEGMENT_DIGITS] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	scan_character
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads the next character of a number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		scan,				The number being read.
+ |				character,			The character read.
+ |	@return:	1,					The character was part of the number.
+ |				0,					The character was not part of the number, which has
+ |									ended, or memory could not be allocated.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int scan_character(largenumber_scan* scan, int character){
+	int state = next_scan_state(scan->state, character);
+
+	if( state == SCAN_ENDED){
+		if( scan->state < SCAN_ENDED){
+			scan->state = SCAN_ENDED;
+		}
+		return 0;
+	}
+	if( state == SCAN_SIGNED && scan->state == SCAN_LEADING){
+		scan->sign = character == '-' ? NEGATIVE : POSITIVE;
+	}
+	scan->state = state;
+
+	if( character >= '0' && character <= '9'){
+		scan->decimal_places += state == SCAN_FRACTION;
+		scan->converting = scan->converting * 10 + (segment) (character - '0');
+
+		///Once a digit holds nine characters, it is stored after the others.
+		if( ++scan->converting_size == SEGMENT_DIGITS){
+			if( !resize_largenumber(scan->number, scan->digits + 1)){
+				scan->state = SCAN_FAILED;
+				return 0;
+			}
+			scan->number->segments[scan->digits++] = scan->converting;
+			scan->converting = 0;
+			scan->converting_size = 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_largenumber_scan
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Starts reading a number that is given a part at a time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	scan,				The number being read.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_scan* init_largenumber_scan(void){
+	largenumber_scan* scan;
+	largenumber_arena* previous;
+
+	if( (scan = malloc(sizeof(largenumber_scan))) == NULL){
+		return NULL;
+	}
+	///The digits grow in a number from the pool, only moved to an arena once finished.
+	previous = use_largenumber_arena(NULL);
+	scan->number = init_sized_largenumber(1);
+	use_largenumber_arena(previous);
+	if( scan->number == NULL){
+		free(scan);
+		return NULL;
+	}
+	scan->digits = 0;
+	scan->converting = 0;
+	scan->converting_size = 0;
+	scan->state = SCAN_LEADING;
+	scan->sign = POSITIVE;
+	scan->decimal_places = 0;
+
+	return scan;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	feed_largenumber_scan
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads the next part of a number. Leading whitespace and a sign are
+ |				skipped, and digits after a decimal point set the decimal position.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		scan,				The number being read.
+ |				characters,			The next part of the number.
+ |				length,				The amount of characters in the part.
+ |	@return:	The amount of characters that were part of the number. If it is less than
+ |				length, the number has ended and the rest belong to whatever follows it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+size_t feed_largenumber_scan(largenumber_scan* scan, const char* characters, size_t length){
+	size_t read;
+
+	for( read = 0; read < length; read++){
+		if( !scan_character(scan, (unsigned char) characters[read])){
+			break;
+		}
+	}
+	return read;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	finish_largenumber_scan
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Ends reading a number, freeing the scan.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		scan,				The number being read.
+ |	@return:	number,				The number that was read.
+ |				NULL,				No digits were read, or an error occured whilst
+ |									allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* finish_largenumber_scan(largenumber_scan* scan){
+	large_number* number = scan->number;
+	segment swapper;
+	size_t i, size = scan->digits;
+	largenumber_arena* previous;
+#if defined(LARGENUMBER_BINARY)
+	large_number* powers[DECIMAL_LEVELS] = {NULL};
+	large_number* converted = NULL;
+	int level;
+#endif
+
+	if( scan->state == SCAN_FAILED || (size == 0 && scan->converting_size == 0)){
+		free_largenumber(number);
+		free(scan);
+		return NULL;
+	}
+	previous = use_largenumber_arena(NULL);
+
+	///The digits were stored most significant first, so they are reversed.
+	for( i = 0; i < size / 2; i++){
+		swapper = number->segments[i];
+		number->segments[i] = number->segments[size - 1 - i];
+		number->segments[size - 1 - i] = swapper;
+	}
+	number->size = size > 0 ? size : 1;
+
+#if defined(LARGENUMBER_BINARY)
+	if( size > 0){
+		converted = binary_segments(number->segments, size, powers);
+		for( level = 0; level < DECIMAL_LEVELS; level++){
+			free_largenumber(powers[level]);
+		}
+	}
+	else{
+		converted = init_largenumber(0);
+	}
+	free_largenumber(number);
+	if( (number = converted) == NULL){
+		free(scan);
+		return restore_arena(NULL, previous);
+	}
+	size = number->size;
+#endif
+
+	///The digits were grouped from the most significant character, so the number is
+	///moved along by the characters of the last partial digit, which are then added.
+	if( scan->converting_size > 0){
+		if( !resize_largenumber(number, number->size + 1)){
+			free_largenumber(number);
+			free(scan);
+			return restore_arena(NULL, previous);
+		}
+		number->segments[size] = multiply_segment(number->segments, number->segments, size,
+												  powers_of_ten[scan->converting_size]);
+		add_segments(number->segments, number->segments, size + 1, &scan->converting, 1);
+	}
+	number->sign = scan->sign;
+	number->decimal_position = scan->decimal_places;
+	trim_largenumber(number);
+	free(scan);
+
+	return restore_arena(number, previous);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	fscan_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads a number from a stream, leaving the stream at the first character
+ |				after it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		stream,				Where the number is read from.
+ |	@return:	number,				The number that was read.
+ |				NULL,				No number could be read, or an error occured whilst
+ |									allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* fscan_largenumber(FILE* stream){
+	largenumber_scan* scan;
+	int character;
+
+	if( (scan = init_largenumber_scan()) == NULL){
+		return NULL;
+	}
+	///The stream does its own buffering, so characters are taken one at a time, and the
+	///first that is not part of the number is put back.
+	while( (character = getc(stream)) != EOF){
+		if( !scan_character(scan, character)){
+			ungetc(character, stream);
+			break;
+		}
+	}
+	return finish_largenumber_scan(scan);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	read_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads a number from a source, SCAN_CHUNK characters at a time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		reader,				Fills a buffer with up to a given amount of characters
+ |									from the source, returning how many it read, with zero
+ |									meaning the source has ended.
+ |				source,				The source passed to the reader.
+ |	@return:	number,				The number that was read.
+ |				NULL,				No number could be read, or an error occured whilst
+ |									allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Characters after the number that were read in the same chunk are lost, so
+ |				the number should end its source, or feed_largenumber_scan used instead.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* read_largenumber(largenumber_reader reader, void* source){
+	largenumber_scan* scan;
+	char chunk[SCAN_CHUNK];
+	size_t length;
+
+	if( (scan = init_largenumber_scan()) == NULL){
+		return NULL;
+	}
+	while( (length = reader(source, chunk, SCAN_CHUNK)) > 0){
+		if( feed_largenumber_scan(scan, chunk, length) < length){
+			break;
+		}
+	}
+	return finish_largenumber_scan(scan);
+}
+
+#if defined(LARGENUMBER_POSIX)
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	read_descriptor
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads characters from a file descriptor, for read_largenumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		source,				The file descriptor.
+ |				buffer, size,		Where the characters are read to, and the most read.
+ |	@return:	The amount of characters read, zero at the end or on an error.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t read_descriptor(void* source, char* buffer, size_t size){
+	ssize_t length;
+
+	//Reads interrupted by a signal are retried.
+	do{
+		length = read(*(int*) source, buffer, size);
+	} while( length < 0 && errno == EINTR);
+	return length > 0 ? (size_t) length : 0;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	fdscan_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads a number from a file descriptor, such as a pipe or socket.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		descriptor,			Where the number is read from.
+ |	@return:	number,				The number that was read.
+ |				NULL,				No number could be read, or an error occured whilst
+ |									allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		As with read_largenumber, the number should end what is being read.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* fdscan_largenumber(int descriptor){
+	return read_largenumber(read_descriptor, &descriptor);
+}
+#endif
+
+#define SAVE_MAGIC		"LNUM"			//Starts every saved number.
+#define SAVE_VERSION	1				//The layout of the header below.
+#define SAVE_BYTE_ORDER	0x01020304		//Written as a segment, to check the byte order.
+#if defined(LARGENUMBER_BINARY)
+#define SAVE_RADIX		1				//Segments are saved in base 2^32.
+#else
+#define SAVE_RADIX		0				//Segments are saved in base 10^9.
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		save_header
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The 32 bytes before the segments of a saved number, which keep the
+ |				segments that follow aligned so they can be used where they lie.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		magic,				SAVE_MAGIC.
+ |				version,			SAVE_VERSION.
+ |				radix,				SAVE_RADIX of the build that saved the number.
+ |				sign,				POSITIVE or NEGATIVE.
+ |				byte_order,			SAVE_BYTE_ORDER, in the byte order of the segments.
+ |				decimal_position,	The fields of the same name in the large number.
+ |				max_dec_places,
+ |				segment_bytes,		The size of every segment.
+ |				size,				The amount of segments that follow.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+typedef struct save_header{
+	char magic[4];
+	uint16_t version;
+	uint8_t radix;
+	uint8_t sign;
+	uint32_t byte_order;
+	int32_t decimal_position;
+	int32_t max_dec_places;
+	uint32_t segment_bytes;
+	uint64_t size;
+} save_header;
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_save_header
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Checks a saved number can be used by this build.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		header,				The header of the saved number.
+ |	@return:	1,					The number can be used.
+ |				0,					The header is not one this build wrote, or the number
+ |									was saved with a different radix or byte order.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_save_header(const save_header* header){
+	return memcmp(header->magic, SAVE_MAGIC, sizeof(header->magic)) == 0
+		   && header->version == SAVE_VERSION && header->radix == SAVE_RADIX
+		   && header->byte_order == SAVE_BYTE_ORDER && header->segment_bytes == sizeof(segment)
+		   && header->sign <= NEGATIVE && header->size > 0
+		   && header->size <= SIZE_MAX / sizeof(segment);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_saved_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Checks every saved segment is below MAXVALUE, so a damaged file can not
+ |				produce a number the other functions would mishandle.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		segments, size,		The saved segments and their amount.
+ |	@return:	1,					Every segment is in range.
+ |				0,					A segment is too large.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Any segment is in range in base 2^32.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_saved_segments(const segment* segments, size_t size){
+#if defined(LARGENUMBER_BINARY)
+	(void) segments;
+	(void) size;
+#else
+	size_t i;
+
+	for( i = 0; i < size; i++){
+		if( segments[i] >= MAXVALUE){
+			return 0;
+		}
+	}
+#endif
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	save_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes a large number to a stream in a binary format that can be loaded or
+ |				viewed without being parsed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		stream,				Where the number is written, opened in binary mode.
+ |				number,				The number being written.
+ |	@return:	1,					The number was written.
+ |				0,					An error occured whilst writing.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		A header giving the sign, radix, decimal position and amount of segments
+ |				is followed by the segments as they are held in memory.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int save_largenumber(FILE* stream, large_number* number){
+	save_header header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SAVE_MAGIC, sizeof(header.magic));
+	header.version = SAVE_VERSION;
+	header.radix = SAVE_RADIX;
+	header.sign = (uint8_t) number->sign;
+	header.byte_order = SAVE_BYTE_ORDER;
+	header.decimal_position = number->decimal_position;
+	header.max_dec_places = number->max_dec_places;
+	header.segment_bytes = sizeof(segment);
+	header.size = number->size;
+
+	return fwrite(&header, sizeof(header), 1, stream) == 1
+		   && fwrite(number->segments, sizeof(segment), number->size, stream) == number->size;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	load_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reads a large number written by save_largenumber from a stream.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		stream,				Where the number is read from, opened in binary mode.
+ |	@return:	number,				The number that was read.
+ |				NULL,				The number could not be read or used by this build, or
+ |									an error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* load_largenumber(FILE* stream){
+	large_number* number;					//Return value.
+	save_header header;
+
+	if( fread(&header, sizeof(header), 1, stream) != 1 || !check_save_header(&header)){
+		return NULL;
+	}
+	if( (number = init_sized_largenumber((size_t) header.size)) == NULL){
+		return NULL;
+	}
+	if( fread(number->segments, sizeof(segment), number->size, stream) != number->size
+	   || !check_saved_segments(number->segments, number->size)){
+		free_largenumber(number);
+		return NULL;
+	}
+	number->sign = (char) header.sign;
+	number->decimal_position = header.decimal_position;
+	number->max_dec_places = header.max_dec_places;
+	trim_largenumber(number);
+
+	return number;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	view_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets up a read only large number that uses the segments of a number
+ |				written by save_largenumber where they lie in memory, without copying.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		view,				The large number being set up.
+ |				data, length,		The saved number and the amount of bytes it takes.
+ |	@return:	1,					The view was set up.
+ |				0,					The data is not a number this build can use, is not
+ |									aligned for its segments, or holds a segment too large
+ |									for the radix.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The view may only be read from, and is never freed. It can be given to any
+ |				function as a number that is not written to. In base 10^9 every segment
+ |				is checked once when the view is set up.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int view_largenumber(large_number* view, const void* data, size_t length){
+	const save_header* header = data;
+	size_t size;
+
+	if( length < sizeof(save_header) || (uintptr_t) data % sizeof(uint64_t) != 0
+	   || !check_save_header(header)){
+		return 0;
+	}
+	size = (size_t) header->size;
+	if( (length - sizeof(save_header)) / sizeof(segment) < size
+	   || !check_saved_segments((const segment*) (header + 1), size)){
+		return 0;
+	}
+
+	view->segments = (segment*) (header + 1);
+	view->size = trimmed_size(view->segments, size);
+	view->size = view->size > 0 ? view->size : 1;
+	view->capacity = view->size;
+	view->sign = view->size == 1 && view->segments[0] == 0 ? POSITIVE : (char) header->sign;
+	view->decimal_position = header->decimal_position;
+	view->max_dec_places = header->max_dec_places;
+	view->arena = NULL;
+
+	return 1;
+}
+
+#if defined(LARGENUMBER_POSIX)
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	map_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Maps a file written by save_largenumber into memory, and views the number
+ |				in it without copying its segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		path				The file holding the number.
+ |	@return:	mapping,			The mapping, whose number field is the read only view.
+ |				NULL,				The file could not be mapped or is not a number this
+ |									build can use.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_mapping* map_largenumber(const char* path){
+	largenumber_mapping* mapping;			//Return value.
+	struct stat status;
+	int descriptor;
+
+	if( (mapping = malloc(sizeof(largenumber_mapping))) == NULL){
+		return NULL;
+	}
+	if( (descriptor = open(path, O_RDONLY)) < 0){
+		free(mapping);
+		return NULL;
+	}
+	//The descriptor is not needed once the file is mapped.
+	if( fstat(descriptor, &status) != 0 || status.st_size <= 0
+	   || (mapping->address = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED,
+								   descriptor, 0)) == MAP_FAILED){
+		close(descriptor);
+		free(mapping);
+		return NULL;
+	}
+	close(descriptor);
+	mapping->length = (size_t) status.st_size;
+
+	if( !view_largenumber(&mapping->number, mapping->address, mapping->length)){
+		munmap(mapping->address, mapping->length);
+		free(mapping);
+		return NULL;
+	}
+
+	return mapping;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	unmap_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Unmaps a file mapped by map_largenumber, after which its view can no longer
+ |				be used.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		mapping				The mapping being released.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void unmap_largenumber(largenumber_mapping* mapping){
+	if( mapping == NULL){
+		return;
+	}
+	munmap(mapping->address, mapping->length);
+	free(mapping);
+}
+#endif
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	MATH FUNCTIONS FOR LARGE NUMBERS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	value_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets up a large number that holds a value in caller supplied storage,
+ |				so single values can be used by the large number operations.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		holding,			The large number being set up.
+ |				holding_segments,	At least three segments the value is stored in.
+ |				value,				The value being held.
+ |	@return:	holding,			The large number that was set up.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* value_largenumber(large_number* holding, segment* holding_segments,
+									   long long value){
+	unsigned long long magnitude;
+
+	holding->segments = holding_segments;
+	holding->capacity = 3;
+	holding->size = 0;
+	holding->sign = value >= 0 ? POSITIVE : NEGATIVE;
+	holding->decimal_position = 0;
+	holding->max_dec_places = 0;
+	holding->arena = NULL;
+
+	magnitude = value >= 0 ? (unsigned long long) value : 0ULL - (unsigned long long) value;
+	do{
+		holding_segments[holding->size++] = magnitude % MAXVALUE;
+	} while( (magnitude /= MAXVALUE) > 0);
+
+	return holding;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	clear_decimals
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Marks a number an operation has written a result into as having no digits
+ |				after the decimal point, as a number the result was newly made in would.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number				The number holding the result.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void clear_decimals(large_number* number){
+	number->decimal_position = 0;
+	number->max_dec_places = 0;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	store_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Replaces the storage of a large number with a result built elsewhere.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number whose storage is replaced.
+ |				segments, capacity,	The new array, allocated from the numbers arena, and its
+ |									capacity.
+ |				size,				The amount of segments in use, possibly untrimmed.
+ |				sign,				The sign of the result.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void store_segments(large_number* number, segment* segments, size_t capacity,
+						   size_t size, char sign){
+	release_storage(number);
+	number->segments = segments;
+	number->capacity = capacity;
+	number->size = size;
+	number->sign = sign;
+	clear_decimals(number);
+	trim_largenumber(number);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	small_value
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the value of a magnitude held in no more than two segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number, of one or two segments.
+ |	@return:	The magnitude of the number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned long long small_value(const large_number* number){
+	if( number->size == 1){
+		return number->segments[0];
+	}
+	return number->segments[1] * (unsigned long long) MAXVALUE + number->segments[0];
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_small_into
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two large numbers of no more than two segments with native arithmetic,
+ |				with the sign of the second one given separately.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		sum,				Where the result is stored, may be either number.
+ |				number_one,			The first part of the addition.
+ |				number_two,			The second part of the addition.
+ |				sign_two,			The sign the second number is treated as having.
+ |	@return:	1,					The addition was a success.
+ |				0,					An error occured whilst allocating, sum is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Two segments are below 2^64, so only the sum of two binary magnitudes can
+ |				carry past a long long, and the carry is the third segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int add_small_into(large_number* sum, large_number* number_one,
+						  large_number* number_two, char sign_two){
+	unsigned long long one = small_value(number_one), two = small_value(number_two), result;
+	segment carry = 0;
+	char sign_sum = number_one->sign;
+
+	if( number_one->sign == sign_two){
+		result = one + two;
+		carry = result < one;
+	}
+	else if( one >= two){
+		result = one - two;
+	}
+	else{
+		result = two - one;
+		sign_sum = sign_two;
+	}
+
+	if( !resize_largenumber(sum, 3)){
+		return 0;							//Allocation failed, return error value.
+	}
+	sum->segments[0] = result % MAXVALUE;
+	result /= MAXVALUE;
+	sum->segments[1] = result % MAXVALUE;
+	sum->segments[2] = result / MAXVALUE + carry;
+	sum->sign = sign_sum;
+	clear_decimals(sum);
+	trim_largenumber(sum);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_signed_into
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two large numbers into a given number, with the sign of the second one
+ |				given separately so subtraction can share the operation.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		sum,				Where the result is stored, may be either number.
+ |				number_one,			The first part of the addition.
+ |				number_two,			The second part of the addition.
+ |				sign_two,			The sign the second number is treated as having.
+ |	@return:	1,					The addition was a success.
+ |				0,					An error occured whilst allocating, sum is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int add_signed_into(large_number* sum, large_number* number_one,
+						   large_number* number_two, char sign_two){
+	large_number* larger, *smaller;
+	size_t larger_size, smaller_size;
+	char sign_one = number_one->sign, sign_sum;
+
+	if( number_one->size <= 2 && number_two->size <= 2){
+		return add_small_into(sum, number_one, number_two, sign_two);
+	}
+
+	///The magnitudes are ordered so that the larger one is always the first array.
+	if( compare_segments(number_one->segments, number_one->size,
+						 number_two->segments, number_two->size) >= 0){
+		larger = number_one;
+		smaller = number_two;
+		sign_sum = sign_one;
+	}
+	else{
+		larger = number_two;
+		smaller = number_one;
+		sign_sum = sign_two;
+	}
+	//The sizes are kept, as resizing the sum also resizes an operand it is the same as.
+	larger_size = larger->size;
+	smaller_size = smaller->size;
+
+	if( !resize_largenumber(sum, larger_size + 1)){
+		return 0;							//Allocation failed, return error value.
+	}
+
+	///When the signs are the same the magnitudes are added, otherwise the smaller
+	///magnitude is negated from the larger and the larger decides the sign.
+	if( sign_one == sign_two){
+		sum->segments[larger_size] = add_segments(sum->segments, larger->segments, larger_size,
+												  smaller->segments, smaller_size);
+	}
+	else{
+		sub_segments(sum->segments, larger->segments, larger_size,
+					 smaller->segments, smaller_size);
+		sum->segments[larger_size] = 0;
+	}
+	sum->sign = sign_sum;
+	clear_decimals(sum);
+	trim_largenumber(sum);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_signed_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two large numbers into a new number, with the sign of the second one
+ |				given separately.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number_one,			The first part of the addition.
+ |				number_two,			The second part of the addition.
+ |				sign_two,			The sign the second number is treated as having.
+ |	@return:	sum,				The value of the two large numbers added.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* add_signed_largenumbers(large_number* number_one,
+											 large_number* number_two, char sign_two){
+	large_number* sum;						//Return value.
+	size_t size = number_one->size > number_two->size ? number_one->size : number_two->size;
+
+	if( (sum = init_sized_largenumber(size + 1)) == NULL){
+		return NULL;						//Allocation failed, return error value.
+	}
+	if( !add_signed_into(sum, number_one, number_two, sign_two)){
+		free_largenumber(sum);
+		sum = NULL;
+		return NULL;
+	}
+
+	return sum;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Add a single value to a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be added to.
+ |				value_adding,		The value that will be added to the number.
+ |	@return:	sum,				The number of the value and large number added together.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* add_largenumber(large_number* number, int value_adding){
+	large_number adding;
+	segment adding_segments[3];
+
+	value_largenumber(&adding, adding_segments, value_adding);
+	return add_signed_largenumbers(number, &adding, adding.sign);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_two_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two large numbers together.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number_one,			The first part of the addition.
+ |				number_two,			The second part of the addition.
+ |	@return:	sum,				The value of the two large numbers added.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* add_two_largenumbers(large_number* number_one, large_number* number_two){
+	return add_signed_largenumbers(number_one, number_two, number_two->sign);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	add_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds two large numbers together, storing the sum in a given number whose
+ |				storage is reused, and only grown if needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		sum,				Where the sum is stored, may be either of the numbers.
+ |				number_one,			The first part of the addition.
+ |				number_two,			The second part of the addition.
+ |	@return:	1,					The addition was a success.
+ |				0,					An error occured whilst allocating, sum is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int add_into_largenumber(large_number* sum, large_number* number_one,
+						 large_number* number_two){
+	return add_signed_into(sum, number_one, number_two, number_two->sign);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sub_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Subtracts a value from a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be minused from.
+ |				value_negate,		The value that will be negated from the large number.
+ |	@return:	negated,			The negated value.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* sub_largenumber(large_number* number, int value_negate){
+	large_number negating;
+	segment negating_segments[3];
+
+	value_largenumber(&negating, negating_segments, value_negate);
+	return add_signed_largenumbers(number, &negating,
+								   negating.sign == POSITIVE ? NEGATIVE : POSITIVE);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sub_two_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gets the value of a number negated by another negated number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value_number,		The number that will be minused from.
+ |				value_negate,		The value that will be negated from the large number.
+ |	@return:	negated,			The negated value.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* sub_two_largenumbers(large_number* value_number, large_number* value_negate){
+	return add_signed_largenumbers(value_number, value_negate,
+								   value_negate->sign == POSITIVE ? NEGATIVE : POSITIVE);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sub_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Negates a large number from another, storing the result in a given number
+ |				whose storage is reused, and only grown if needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		negated,			Where the result is stored, may be either of the numbers.
+ |				value_number,		The number that will be minused from.
+ |				value_negate,		The value that will be negated from the large number.
+ |	@return:	1,					The subtraction was a success.
+ |				0,					An error occured whilst allocating, negated is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int sub_into_largenumber(large_number* negated, large_number* value_number,
+						 large_number* value_negate){
+	return add_signed_into(negated, value_number, value_negate,
+						   value_negate->sign == POSITIVE ? NEGATIVE : POSITIVE);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	compare_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Compares the values of two large numbers.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number_one,			The first number.
+ |				number_two,			The second number.
+ |	@return:	1,					The first number is larger.
+ |				0,					The numbers are equal.
+ |				-1,					The second number is larger.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int compare_largenumber(large_number* number_one, large_number* number_two){
+	int compared;
+
+	///Zero is always positive, so differing signs decide the comparison alone.
+	if( number_one->sign != number_two->sign){
+		return number_one->sign == POSITIVE ? 1 : -1;
+	}
+	if( number_one->size == 1 && number_two->size == 1){
+		compared = (number_one->segments[0] > number_two->segments[0])
+				   - (number_one->segments[0] < number_two->segments[0]);
+	}
+	else{
+		compared = compare_segments(number_one->segments, number_one->size,
+									number_two->segments, number_two->size);
+	}
+
+	return number_one->sign == POSITIVE ? compared : -compared;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	div_two_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a large number by another large number, truncating towards zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value_number,		The number that will be divided.
+ |				value_divide,		The number it will be divided by.
+ |	@return:	divided,			The quotient.
+ |				NULL,				An error occured whilst allocating.
+ |				0,					A divide by zero was attempted.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* div_two_largenumbers(large_number* value_number, large_number* value_divide){
+	large_number* divided;					//Return value.
+
+	if( (divided = init_sized_largenumber(1)) == NULL){
+		return NULL;						//Allocation failed, return error value.
+	}
+
+	///If a divide by zero is attempted, the zero value is returned.
+	if( !divmod_largenumber(divided, NULL, value_number, value_divide)){
+		free_largenumber(divided);
+		divided = NULL;
+		return NULL;
+	}
+
+	return divided;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	mod_two_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gets the remainder of a large number divided by another large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value_number,		The number that will be divided.
+ |				value_divide,		The number it will be divided by.
+ |	@return:	remainder,			The remainder, with the sign of the divided number.
+ |				NULL,				An error occured whilst allocating.
+ |				0,					A divide by zero was attempted.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* mod_two_largenumbers(large_number* value_number, large_number* value_divide){
+	large_number* remainder;				//Return value.
+
+	if( (remainder = init_sized_largenumber(1)) == NULL){
+		return NULL;						//Allocation failed, return error value.
+	}
+
+	///If a divide by zero is attempted, the zero value is returned.
+	if( !divmod_largenumber(NULL, remainder, value_number, value_divide)){
+		free_largenumber(remainder);
+		remainder = NULL;
+		return NULL;
+	}
+
+	return remainder;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divmod_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a large number by another large number, finding both the quotient
+ |				and the remainder in one pass.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the quotient is stored, or NULL if unwanted.
+ |				remainder,			Where the remainder is stored, or NULL if unwanted.
+ |				value_number,		The number that will be divided.
+ |				value_divide,		The number it will be divided by.
+ |	@return:	1,					The division was a success.
+ |				0,					An error occured whilst allocating, quotient and remainder
+ |									are unchanged.
+ |				-1,					A divide by zero was attempted, quotient and remainder
+ |									are unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The quotient is truncated towards zero and the remainder takes the sign of
+ |				the divided number, as with the / and % operators. The quotient and
+ |				remainder may be either of the numbers, but not each other.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int divmod_largenumber(large_number* quotient, large_number* remainder,
+					   large_number* value_number, large_number* value_divide){
+	segment* quotient_segments, *remainder_segments;
+	size_t quotient_size, remainder_size, quotient_capacity, remainder_capacity;
+	largenumber_arena* quotient_arena = quotient == NULL ? NULL : quotient->arena;
+	largenumber_arena* remainder_arena = remainder == NULL ? NULL : remainder->arena;
+	char quotient_sign = value_number->sign == value_divide->sign ? POSITIVE : NEGATIVE;
+	char remainder_sign = value_number->sign;
+
+	if( value_divide->size == 1 && value_divide->segments[0] == 0){
+		return -1;
+	}
+
+	///When the divisor is the larger, the quotient is zero and the remainder is the number.
+	if( compare_segments(value_number->segments, value_number->size,
+						 value_divide->segments, value_divide->size) < 0){
+		if( remainder != NULL && remainder != value_number){
+			if( !resize_largenumber(remainder, value_number->size)){
+				return 0;
+			}
+			memcpy(remainder->segments, value_number->segments,
+				   value_number->size * sizeof(segment));
+			remainder->size = value_number->size;
+			remainder->sign = remainder_sign;
+		}
+		if( remainder != NULL){
+			clear_decimals(remainder);
+		}
+		if( quotient != NULL){
+			quotient->size = 1;
+			quotient->segments[0] = 0;
+			quotient->sign = POSITIVE;
+			clear_decimals(quotient);
+		}
+		return 1;
+	}
+
+	///The quotient and remainder are built in new arrays, so the numbers can be reused as
+	///the destinations, which then replace the destinations storage. The sizes are kept, as
+	///storing the quotient also changes an operand it is the same as.
+	quotient_size = quotient_capacity = value_number->size - value_divide->size + 1;
+	remainder_size = remainder_capacity = value_divide->size;
+	if( (quotient_segments = alloc_segments(&quotient_capacity, quotient_arena)) == NULL){
+		return 0;
+	}
+	if( (remainder_segments = alloc_segments(&remainder_capacity, remainder_arena)) == NULL){
+		release_segments(quotient_segments, quotient_capacity, quotient_arena);
+		return 0;
+	}
+	if( !divide_segments(quotient_segments, remainder_segments, value_number->segments,
+						 value_number->size, value_divide->segments, value_divide->size)){
+		release_segments(quotient_segments, quotient_capacity, quotient_arena);
+		release_segments(remainder_segments, remainder_capacity, remainder_arena);
+		return 0;
+	}
+
+	if( quotient != NULL){
+		store_segments(quotient, quotient_segments, quotient_capacity, quotient_size,
+					   quotient_sign);
+	}
+	else{
+		release_segments(quotient_segments, quotient_capacity, NULL);
+	}
+	if( remainder != NULL){
+		store_segments(remainder, remainder_segments, remainder_capacity, remainder_size,
+					   remainder_sign);
+	}
+	else{
+		release_segments(remainder_segments, remainder_capacity, NULL);
+	}
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	div_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a large number by a single value, truncating towards zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be divided.
+ |				value_divide,		The value it will be divided by.
+ |	@return:	divided,			The quotient.
+ |				NULL,				An error occured whilst allocating.
+ |				0,					A divide by zero was attempted.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* div_largenumber(large_number* number, int value_divide){
+	large_number* divided;					//Return value.
+
+	if( (divided = init_sized_largenumber(1)) == NULL){
+		return NULL;						//Allocation failed, return error value.
+	}
+
+	///If a divide by zero is attempted, the zero value is returned.
+	if( !divmod_value_largenumber(divided, NULL, number, value_divide)){
+		free_largenumber(divided);
+		divided = NULL;
+		return NULL;
+	}
+
+	return divided;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	mod_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Gets the remainder of a large number divided by a single value.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be divided.
+ |				value_divide,		The value it will be divided by.
+ |	@return:	remainder,			The remainder, with the sign of the divided number.
+ |				NULL,				An error occured whilst allocating.
+ |				0,					A divide by zero was attempted.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* mod_largenumber(large_number* number, int value_divide){
+	int remainder = 0;
+
+	///Only the remainder is needed, so no quotient is written.
+	divmod_value_largenumber(NULL, &remainder, number, value_divide);
+	return init_largenumber(remainder);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divmod_value_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides a large number by a single value, finding both the quotient and
+ |				the remainder in one pass from the most significant segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		quotient,			Where the quotient is stored, may be the number, or NULL
+ |									if unwanted.
+ |				remainder,			Where the remainder is stored, or NULL if unwanted.
+ |				number,				The number that will be divided.
+ |				value_divide,		The value it will be divided by.
+ |	@return:	1,					The division was a success.
+ |				0,					An error occured whilst allocating, quotient and remainder
+ |									are unchanged.
+ |				-1,					A divide by zero was attempted, quotient and remainder
+ |									are unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The quotient is truncated towards zero and the remainder takes the sign of
+ |				the divided number, as with the / and % operators.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int divmod_value_largenumber(large_number* quotient, int* remainder, large_number* number,
+							 int value_divide){
+	segment divisor, remaining;
+	size_t size = number->size;
+	char sign = number->sign;
+
+	if( value_divide == 0){
+		return -1;
+	}
+	//The magnitude is taken without negating, so the most negative value is allowed.
+	divisor = value_divide < 0 ? 0U - (segment) value_divide : (segment) value_divide;
+
+	if( quotient == NULL){
+		remaining = divide_segment(NULL, number->segments, size, divisor);
+	}
+	else{
+		if( quotient != number && !resize_largenumber(quotient, size)){
+			return 0;
+		}
+		remaining = divide_segment(quotient->segments, number->segments, size, divisor);
+		quotient->size = size;
+		quotient->sign = (sign == NEGATIVE) != (value_divide < 0) ? NEGATIVE : POSITIVE;
+		clear_decimals(quotient);
+		trim_largenumber(quotient);
+	}
+
+	if( remainder != NULL){
+		*remainder = sign == NEGATIVE ? -(int) remaining : (int) remaining;
+	}
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies a single value to a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be multiplied.
+ |				value_multiplying,	The value that will be multiplied to the number.
+ |	@return:	product,			The value of the large number multiplied by given value.
+ |				NULL,				An error occured whilst allocating
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* multiply_largenumber(large_number* number, int value_multiplying){
+	large_number multiplying;
+	segment multiplying_segments[3];
+
+	value_largenumber(&multiplying, multiplying_segments, value_multiplying);
+	return multiply_two_largenumbers(number, &multiplying);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_two_largenumbers
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two large numbers together.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		mult_one,			The first number that will be multiplied.
+ |				mult_two,			The second number that will be multiplied.
+ |	@return:	product,			The value of the two numbers multiplied together.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* multiply_two_largenumbers(large_number* mult_one, large_number* mult_two){
+	large_number* product;					//Return value.
+
+	if( (product = init_sized_largenumber(mult_one->size + mult_two->size)) == NULL){
+		return NULL;
+	}
+	if( !multiply_into_largenumber(product, mult_one, mult_two)){
+		free_largenumber(product);
+		product = NULL;
+		return NULL;
+	}
+
+	return product;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two large numbers together, storing the product in a given
+ |				number whose storage is reused, and only grown if needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		product,			Where the product is stored, may be either of the numbers.
+ |				mult_one,			The first number that will be multiplied.
+ |				mult_two,			The second number that will be multiplied.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating, product is unchanged
+ |									if it is one of the numbers, otherwise it is set to zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int multiply_into_largenumber(large_number* product, large_number* mult_one,
+							  large_number* mult_two){
+	segment* multiplied, small_product[LARGENUMBER_INLINE];
+	size_t size = mult_one->size + mult_two->size, capacity = size;
+	char sign = mult_one->sign == mult_two->sign ? POSITIVE : NEGATIVE;
+	unsigned long long value;
+
+	///A product that fits inside a number is built on the stack, with single segments
+	///multiplied natively, so no array is allocated even when the product is an operand.
+	if( size <= LARGENUMBER_INLINE){
+		if( size == 2){
+			value = (unsigned long long) mult_one->segments[0] * mult_two->segments[0];
+			small_product[0] = value % MAXVALUE;
+			small_product[1] = value / MAXVALUE;
+		}
+		else if( !multiply_segments(small_product, mult_one->segments, mult_one->size,
+									mult_two->segments, mult_two->size)){
+			return 0;
+		}
+		if( !resize_largenumber(product, size)){
+			return 0;
+		}
+		memcpy(product->segments, small_product, size * sizeof(segment));
+		product->sign = sign;
+		clear_decimals(product);
+		trim_largenumber(product);
+		return 1;
+	}
+
+	///The product can not be built over an operand it is the same as, so in that case it is
+	///built in a new array which then replaces the products storage.
+	if( product == mult_one || product == mult_two){
+		if( (multiplied = alloc_segments(&capacity, product->arena)) == NULL){
+			return 0;
+		}
+		if( !multiply_segments(multiplied, mult_one->segments, mult_one->size,
+							   mult_two->segments, mult_two->size)){
+			release_segments(multiplied, capacity, product->arena);
+			return 0;
+		}
+		store_segments(product, multiplied, capacity, size, sign);
+		return 1;
+	}
+	else{
+		if( !resize_largenumber(product, size)){
+			return 0;
+		}
+		if( !multiply_segments(product->segments, mult_one->segments, mult_one->size,
+							   mult_two->segments, mult_two->size)){
+			product->size = 1;
+			product->segments[0] = 0;
+			product->sign = POSITIVE;
+			return 0;
+		}
+	}
+	product->sign = sign;
+	clear_decimals(product);
+	trim_largenumber(product);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sqr_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Squares a large number, finding every cross product only once.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number that will be squared.
+ |	@return:	square,				The value of the number multiplied by itself.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* sqr_largenumber(large_number* number){
+	large_number* square;					//Return value.
+
+	if( (square = init_sized_largenumber(2 * number->size)) == NULL){
+		return NULL;
+	}
+	if( !sqr_into_largenumber(square, number)){
+		free_largenumber(square);
+		square = NULL;
+		return NULL;
+	}
+
+	return square;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sqr_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Squares a large number, storing the square in a given number whose storage
+ |				is reused, and only grown if needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		square,				Where the square is stored, may be the number.
+ |				number,				The number that will be squared.
+ |	@return:	1,					The squaring was a success.
+ |				0,					An error occured whilst allocating, as with
+ |									multiply_into_largenumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Multiplying a number by itself with multiply_into_largenumber squares it
+ |				in the same way.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int sqr_into_largenumber(large_number* square, large_number* number){
+	return multiply_into_largenumber(square, number, number);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	segment_view
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Holds part of a segment array as a read only large number, without copying
+ |				it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		view,				The large number being set up.
+ |				segments, size,		The part of the array it holds.
+ |	@return:	The view.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* segment_view(large_number* view, segment* segments, size_t size){
+	static segment zero = 0;
+
+	view->size = trimmed_size(segments, size);
+	view->segments = view->size > 0 ? segments : &zero;
+	view->size = view->size > 0 ? view->size : 1;
+	view->capacity = view->size;
+	view->sign = POSITIVE;
+	view->decimal_position = 0;
+	view->max_dec_places = 0;
+	view->arena = NULL;
+
+	return view;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	multiply_signed_into
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds the product of two large numbers onto a given number, with the sign of
+ |				the product given separately so subtraction can share the operation.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		sum,				The number the product is added onto, may be either of
+ |									the numbers multiplied.
+ |				mult_one,			The first number that will be multiplied.
+ |				mult_two,			The second number that will be multiplied.
+ |				sign_product,		The sign the product is treated as having.
+ |	@return:	1,					The product was added.
+ |				0,					An error occured whilst allocating, sum is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		A product with the same sign as the sum, that would be multiplied with the
+ |				schoolbook method, has each partial product added straight onto the sum.
+ |				Otherwise the product is built in a scratch array and then added.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int multiply_signed_into(large_number* sum, large_number* mult_one,
+								large_number* mult_two, char sign_product){
+	large_number product, *longer = mult_one, *shorter = mult_two;
+	segment* multiplied;
+	size_t size = mult_one->size + mult_two->size, capacity = size, i, j;
+	unsigned long long value_adding;
+	segment carry;
+	int success;
+
+	if( mult_one->size < mult_two->size){
+		longer = mult_two;
+		shorter = mult_one;
+	}
+
+	if( sum != mult_one && sum != mult_two && shorter->size < karatsuba_threshold
+		&& (sum->sign == sign_product || (sum->size == 1 && sum->segments[0] == 0))){
+		if( !resize_largenumber(sum, (size > sum->size ? size : sum->size) + 1)){
+			return 0;
+		}
+		sum->sign = sign_product;
+		clear_decimals(sum);
+		///Every segment of the shorter number adds a partial product onto the sum, whose
+		///carry is moved through the segments above it.
+		for( i = 0; i < shorter->size; i++){
+			carry = addmul_segment(sum->segments + i, longer->segments, longer->size,
+								   shorter->segments[i]);
+			for( j = i + longer->size; carry != 0; j++){
+				value_adding = (unsigned long long) sum->segments[j] + carry;
+				carry = value_adding >= MAXVALUE;
+				sum->segments[j] = (segment) (carry ? value_adding - MAXVALUE : value_adding);
+			}
+		}
+		trim_largenumber(sum);
+		return 1;
+	}
+
+	if( (multiplied = alloc_segments(&capacity, NULL)) == NULL){
+		return 0;
+	}
+	if( !multiply_segments(multiplied, mult_one->segments, mult_one->size,
+						   mult_two->segments, mult_two->size)){
+		release_segments(multiplied, capacity, NULL);
+		return 0;
+	}
+	success = add_signed_into(sum, sum, segment_view(&product, multiplied, size), sign_product);
+	release_segments(multiplied, capacity, NULL);
+
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	addmul_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Adds the product of two large numbers onto a given number, without building
+ |				the product as a number of its own.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		sum,				The number the product is added onto, may be either of
+ |									the numbers multiplied.
+ |				mult_one,			The first number that will be multiplied.
+ |				mult_two,			The second number that will be multiplied.
+ |	@return:	1,					The product was added.
+ |				0,					An error occured whilst allocating, sum is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int addmul_into_largenumber(large_number* sum, large_number* mult_one,
+							large_number* mult_two){
+	return multiply_signed_into(sum, mult_one, mult_two,
+								mult_one->sign == mult_two->sign ? POSITIVE : NEGATIVE);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	submul_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Negates the product of two large numbers from a given number, without
+ |				building the product as a number of its own.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		negated,			The number the product is negated from, may be either of
+ |									the numbers multiplied.
+ |				mult_one,			The first number that will be multiplied.
+ |				mult_two,			The second number that will be multiplied.
+ |	@return:	1,					The product was negated.
+ |				0,					An error occured whilst allocating, negated is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int submul_into_largenumber(large_number* negated, large_number* mult_one,
+							large_number* mult_two){
+	return multiply_signed_into(negated, mult_one, mult_two,
+								mult_one->sign == mult_two->sign ? NEGATIVE : POSITIVE);
+}
+
+#define POW_MAX_WINDOW	4				//Most exponent bits handled by one multiplication.
+#if defined(LARGENUMBER_BINARY)
+#define RADIX_DIGIT		2				//The digit segments are made up of.
+#define SEGMENT_RADIX	32				//Radix digits held by each segment.
+#else
+#define RADIX_DIGIT		10
+#define SEGMENT_RADIX	SEGMENT_DIGITS
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	radix_power
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds a power of RADIX_DIGIT that fits in a segment.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The power, less than SEGMENT_RADIX.
+ |	@return:	RADIX_DIGIT raised to the power.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment radix_power(size_t digits){
+	segment power = 1;
+
+	while( digits-- > 0){
+		power *= RADIX_DIGIT;
+	}
+	return power;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	trailing_radix_digits
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Counts the RADIX_DIGIT digits at the end of a large number that are zero,
+ |				which is how many times RADIX_DIGIT divides it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The non zero number being looked at.
+ |	@return:	The amount of zero digits.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t trailing_radix_digits(const large_number* number){
+	size_t digits = 0, i = 0;
+	segment lowest;
+
+	while( number->segments[i] == 0){
+		i++;
+	}
+	for( lowest = number->segments[i]; lowest % RADIX_DIGIT == 0; lowest /= RADIX_DIGIT){
+		digits++;
+	}
+	return i * SEGMENT_RADIX + digits;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	shift_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies a large number in place by a power of RADIX_DIGIT, by moving
+ |				whole segments up and multiplying by what is left.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being shifted.
+ |				digits,				The power of RADIX_DIGIT it is multiplied by.
+ |	@return:	1,					The shift was a success.
+ |				0,					An error occured whilst allocating, the number is
+ |									unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int shift_largenumber(large_number* number, size_t digits){
+	size_t whole = digits / SEGMENT_RADIX, size = number->size;
+
+	if( number->size == 1 && number->segments[0] == 0){
+		return 1;
+	}
+	if( whole > SIZE_MAX / sizeof(segment) - size - 1
+	   || !resize_largenumber(number, size + whole + 1)){
+		return 0;
+	}
+	memmove(number->segments + whole, number->segments, size * sizeof(segment));
+	memset(number->segments, 0, whole * sizeof(segment));
+	number->segments[whole + size] = multiply_segment(number->segments + whole,
+													  number->segments + whole, size,
+													  radix_power(digits % SEGMENT_RADIX));
+	trim_largenumber(number);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	pow_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a large number to a power, using sliding window exponentiation.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		base,				The number being raised.
+ |				exponent,			The power it is raised to, zero giving one.
+ |	@return:	powered,			The value of the base raised to the exponent.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Zero digits at the end of the base are taken off and put back on the
+ |				result as a shift, so powers of ten, and powers of the segment base, are
+ |				built directly. The rest of the base is raised by squaring, with the
+ |				exponent read a window of bits at a time, each window needing only one
+ |				multiplication by a precomputed odd power.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* pow_largenumber(large_number* base, unsigned int exponent){
+	large_number* powered = NULL, *working = NULL, *swapper;	//Return value is powered.
+	large_number* odd_powers[1 << (POW_MAX_WINDOW - 1)] = { NULL };
+	size_t digits, whole, i;
+	int bits = 0, window, low, high, count = 0, success = 1;
+	unsigned int bits_value;
+	largenumber_arena* previous;
+
+	if( exponent == 0 || (base->size == 1 && base->segments[0] == 0)){
+		return init_largenumber(exponent == 0 ? 1 : 0);
+	}
+	///The powers are found in numbers from the pool, and only the result is moved to an
+	///arena in use.
+	previous = use_largenumber_arena(NULL);
+	while( bits < 32 && (exponent >> bits) > 0){
+		bits++;
+	}
+
+	///The zero digits are taken off the base, which is held without them in new storage.
+	digits = trailing_radix_digits(base);
+	whole = digits / SEGMENT_RADIX;
+	if( digits > SIZE_MAX / exponent
+	   || (odd_powers[0] = init_sized_largenumber(base->size - whole)) == NULL){
+		return restore_arena(NULL, previous);
+	}
+	divide_segment(odd_powers[0]->segments, base->segments + whole, base->size - whole,
+				   radix_power(digits % SEGMENT_RADIX));
+	odd_powers[0]->sign = base->sign;
+	trim_largenumber(odd_powers[0]);
+
+	///A base of one, once stripped, is only a sign, so no multiplying is needed.
+	if( odd_powers[0]->size == 1 && odd_powers[0]->segments[0] == 1){
+		powered = odd_powers[0];
+		if( !(exponent & 1)){
+			powered->sign = POSITIVE;
+		}
+		if( !shift_largenumber(powered, digits * exponent)){
+			free_largenumber(powered);
+			powered = NULL;
+			return restore_arena(NULL, previous);
+		}
+		return restore_arena(powered, previous);
+	}
+
+	///The odd powers up to the window are found from the square of the base.
+	window = bits > 16 ? 4 : bits > 6 ? 3 : bits > 2 ? 2 : 1;
+	if( window > 1){
+		if( (swapper = sqr_largenumber(odd_powers[0])) == NULL){
+			success = 0;
+		}
+		for( count = 1; success && count < 1 << (window - 1); count++){
+			if( (odd_powers[count] = multiply_two_largenumbers(odd_powers[count-1],
+															   swapper)) == NULL){
+				success = 0;
+			}
+		}
+		free_largenumber(swapper);
+	}
+	if( success && ((powered = init_largenumber(1)) == NULL
+	   || (working = init_largenumber(0)) == NULL)){
+		success = 0;
+	}
+
+	///From the top, every zero bit squares the result, and every window of bits starting
+	///and ending with a one squares it once per bit and multiplies by its odd power. The
+	///result and working numbers swap after each step, so their storage is reused.
+	for( high = bits - 1; success && high >= 0; ){
+		if( !((exponent >> high) & 1)){
+			low = high;
+			bits_value = 0;
+		}
+		else{
+			for( low = high - window + 1 < 0 ? 0 : high - window + 1; !((exponent >> low) & 1); low++);
+			bits_value = (exponent >> low) & ((1U << (high - low + 1)) - 1);
+		}
+		for( i = 0; success && i < (size_t) (high - low + 1); i++){
+			if( !sqr_into_largenumber(working, powered)){
+				success = 0;
+				break;
+			}
+			swapper = powered;
+			powered = working;
+			working = swapper;
+		}
+		if( success && bits_value != 0){
+			if( !multiply_into_largenumber(working, powered, odd_powers[bits_value >> 1])){
+				success = 0;
+				break;
+			}
+			swapper = powered;
+			powered = working;
+			working = swapper;
+		}
+		high = low - 1;
+	}
+
+	///The zero digits of the base, repeated once per power, are put back.
+	if( success && !shift_largenumber(powered, digits * exponent)){
+		success = 0;
+	}
+
+	free_largenumber(working);
+	for( i = 0; i < (size_t) 1 << (POW_MAX_WINDOW - 1); i++){
+		free_largenumber(odd_powers[i]);
+	}
+	if( !success){
+		free_largenumber(powered);
+		powered = NULL;
+		return restore_arena(NULL, previous);
+	}
+
+	return restore_arena(powered, previous);
+}
+
+#if defined(LARGENUMBER_BINARY)
+#define ROOT_SEARCH_BITS	64			//Bits in any root of a number of two segments.
+#define SEGMENT_BITS		32			//Bits held by each segment.
+#else
+#define ROOT_SEARCH_BITS	60
+#define SEGMENT_BITS		30
+#endif
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	unsigned_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Holds an unsigned value as a large number, in storage given by the caller.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		holding,			The large number being set up.
+ |				holding_segments,	Storage for at least three segments.
+ |				value,				The value it holds.
+ |	@return:	The holding number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* unsigned_largenumber(large_number* holding, segment* holding_segments,
+										  unsigned long long value){
+	value_largenumber(holding, holding_segments, 0);
+	holding->size = 0;
+	do{
+		holding_segments[holding->size++] = value % MAXVALUE;
+	} while( (value /= MAXVALUE) > 0);
+
+	return holding;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	newton_root
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Brings a value down to the root of a number, rounded down, with newton's
+ |				method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		root,				A value no less than the root, which is replaced by the
+ |									root.
+ |				power,				Where the root raised to the degree is stored.
+ |				number,				The number, which is positive.
+ |				degree,				The degree of the root, at least two.
+ |	@return:	1,					The root was found.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		From above the root, each step (r * (degree - 1) + number / r^(degree - 1))
+ |				/ degree stays no less than the root, so the first value whose power is
+ |				no more than the number is the root. A value close to the root takes one
+ |				step, and perhaps taking away one.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int newton_root(large_number* root, large_number* power, large_number* number,
+					   unsigned int degree){
+	large_number* lower = NULL, *quotient, shifted_number, shifted_lower;
+	large_number multiplier;
+	segment multiplier_segments[3];
+	size_t zeros;
+	int stepped = 0, success = 1;
+
+	if( (quotient = init_largenumber(0)) == NULL){
+		return 0;
+	}
+	for( ;;){
+		if( (lower = pow_largenumber(root, degree - 1)) == NULL
+		   || !multiply_into_largenumber(power, lower, root)){
+			success = 0;
+			break;
+		}
+		if( compare_segments(power->segments, power->size, number->segments, number->size) <= 0){
+			break;
+		}
+
+		///Straight after a step the root is most likely one above, which is cheaper to try
+		///than another step.
+		if( stepped){
+			stepped = 0;
+			if( !sub_into_largenumber(root, root, value_largenumber(&multiplier,
+																	multiplier_segments, 1))){
+				success = 0;
+				break;
+			}
+			free_largenumber(lower);
+			lower = NULL;
+			continue;
+		}
+
+		///The power's zero segments are taken off both numbers, which leaves the quotient
+		///the same but the division smaller.
+		for( zeros = 0; lower->segments[zeros] == 0; zeros++);
+		shifted_number = *number;
+		shifted_lower = *lower;
+		shifted_number.segments += zeros < number->size ? zeros : 0;
+		shifted_number.size -= zeros < number->size ? zeros : 0;
+		shifted_lower.segments += zeros;
+		shifted_lower.size -= zeros;
+		if( zeros >= number->size){
+			quotient->size = 1;
+			quotient->segments[0] = 0;
+		}
+		else if( divmod_largenumber(quotient, NULL, &shifted_number, &shifted_lower) != 1){
+			success = 0;
+			break;
+		}
+		if( !multiply_into_largenumber(root, root, unsigned_largenumber(&multiplier,
+																		multiplier_segments,
+																		degree - 1))
+		   || !add_into_largenumber(root, root, quotient)
+		   || divmod_largenumber(root, NULL, root, unsigned_largenumber(&multiplier,
+																		multiplier_segments,
+																		degree)) != 1){
+			success = 0;
+			break;
+		}
+		stepped = 1;
+		free_largenumber(lower);
+		lower = NULL;
+	}
+
+	free_largenumber(lower);
+	free_largenumber(quotient);
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	search_root
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the root of a number rounded down one bit at a time, for numbers whose
+ |				root fits in two segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number, which is positive and has no more than twice
+ |									the degree in segments.
+ |				degree,				The degree of the root, at least two.
+ |	@return:	root,				The root.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* search_root(large_number* number, unsigned int degree){
+	large_number candidate_value, *power;
+	segment candidate_segments[3];
+	unsigned long long root = 0, candidate;
+	int bit = ROOT_SEARCH_BITS;
+	int compared;
+
+	///The number is below 2^(bits in its segments), so its root is below 2^(those bits / degree).
+	if( number->size * SEGMENT_BITS / degree + 1 < (size_t) bit){
+		bit = (int) (number->size * SEGMENT_BITS / degree + 1);
+	}
+	while( --bit >= 0){
+		candidate = root | 1ULL << bit;
+		if( (power = pow_largenumber(unsigned_largenumber(&candidate_value, candidate_segments,
+														  candidate), degree)) == NULL){
+			return NULL;
+		}
+		compared = compare_segments(power->segments, power->size, number->segments, number->size);
+		free_largenumber(power);
+		if( compared <= 0){
+			root = candidate;
+		}
+	}
+
+	if( (power = init_sized_largenumber(3)) == NULL){
+		return NULL;
+	}
+	unsigned_largenumber(&candidate_value, candidate_segments, root);
+	memcpy(power->segments, candidate_segments, candidate_value.size * sizeof(segment));
+	power->size = candidate_value.size;
+	return power;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	nth_root
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the root of a number rounded down, doubling the precision of the root
+ |				at each step.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number, which is positive.
+ |				degree,				The degree of the root, at least two.
+ |				power,				Where the root raised to the degree is stored.
+ |	@return:	root,				The root.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The root of the number without its lowest degree * k segments, plus one and
+ |				moved up k segments, is above the root by less than MAXVALUE^k. With k
+ |				about a quarter of the root's length, one newton step from there lands
+ |				within one or two of the root, so each size only costs a few
+ |				multiplications and a division at that size.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* nth_root(large_number* number, unsigned int degree, large_number* power){
+	large_number* root, *top, *top_power;
+	large_number one;
+	segment one_segments[3];
+	size_t segments;
+
+	if( number->size <= 2 * (size_t) degree){
+		root = search_root(number, degree);
+	}
+	else{
+		segments = (number->size - 2) / (2 * (size_t) degree);
+		segments = (segments > 0 ? segments : 1) * degree;
+		if( (top = init_sized_largenumber(number->size - segments)) == NULL){
+			return NULL;
+		}
+		memcpy(top->segments, number->segments + segments,
+			   (number->size - segments) * sizeof(segment));
+		if( (top_power = init_largenumber(0)) == NULL){
+			free_largenumber(top);
+			return NULL;
+		}
+		root = nth_root(top, degree, top_power);
+		free_largenumber(top_power);
+		free_largenumber(top);
+
+		///The root of the top is rounded up and moved up, to start above the root.
+		if( root != NULL && (!add_into_largenumber(root, root, value_largenumber(&one,
+																				  one_segments, 1))
+							 || !shift_largenumber(root, segments / degree * SEGMENT_RADIX))){
+			free_largenumber(root);
+			root = NULL;
+		}
+	}
+
+	if( root != NULL && !newton_root(root, power, number, degree)){
+		free_largenumber(root);
+		root = NULL;
+	}
+	return root;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	assign_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets a large number to the value of another.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being set.
+ |				value,				The number whose value it takes.
+ |	@return:	1,					The value was set.
+ |				0,					An error occured whilst allocating, the number is
+ |									unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int assign_largenumber(large_number* number, const large_number* value){
+	if( number == value){
+		return 1;
+	}
+	if( !resize_largenumber(number, value->size)){
+		return 0;
+	}
+	memcpy(number->segments, value->segments, value->size * sizeof(segment));
+	number->sign = value->sign;
+	number->decimal_position = value->decimal_position;
+	number->max_dec_places = value->max_dec_places;
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sqrt_value
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the square root of a value rounded down, one bit at a time.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		value,				The value whose root is found.
+ |	@return:	The root.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned long long sqrt_value(unsigned long long value){
+	unsigned long long root = 0, bit = 1ULL << 62;
+
+	while( bit > value){
+		bit >>= 2;
+	}
+	for( ; bit != 0; bit >>= 2){
+		if( value >= root + bit){
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else{
+			root >>= 1;
+		}
+	}
+	return root;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	karatsuba_sqrt
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the square root of a normalised number rounded down, and what is
+ |				left, with zimmermann's karatsuba square root.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		root,				Where the root is stored.
+ |				remainder,			Where the number less the square of the root is stored.
+ |				number,				The number, with an even amount of segments, the top of
+ |									which is at least MAXVALUE / 4. It is not changed.
+ |	@return:	1,					The root was found.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The number is split as top * MAXVALUE^2l + middle * MAXVALUE^l + low, for
+ |				l a quarter of its length. With the root s and remainder r of the top, the
+ |				root is s * MAXVALUE^l + q for q the quotient of (r * MAXVALUE^l + middle)
+ |				by 2s, or one less. This is one newton step from the root of the top, so
+ |				each half of the precision only costs a division and a square of a quarter
+ |				of the length.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int karatsuba_sqrt(large_number* root, large_number* remainder, large_number* number){
+	large_number* quotient = NULL, *twice = NULL, *square = NULL;
+	large_number top, part, holding;
+	segment holding_segments[3];
+	unsigned long long value, value_root;
+	size_t low = number->size / 4;
+	int success;
+
+	if( number->size == 2){
+		value = number->segments[1] * (unsigned long long) MAXVALUE + number->segments[0];
+		value_root = sqrt_value(value);
+		return assign_largenumber(root, unsigned_largenumber(&holding, holding_segments,
+															 value_root))
+			   && assign_largenumber(remainder, unsigned_largenumber(&holding, holding_segments,
+																	 value - value_root * value_root));
+	}
+
+	top = *number;
+	top.segments += 2 * low;
+	top.size -= 2 * low;
+	success = karatsuba_sqrt(root, remainder, &top)
+			  && (quotient = init_largenumber(0)) != NULL
+			  && (twice = init_largenumber(0)) != NULL
+			  && (square = init_largenumber(0)) != NULL;
+
+	///The remainder of the top, with the middle segments below it, is divided by twice the
+	///root of the top.
+	success = success
+			  && shift_largenumber(remainder, low * SEGMENT_RADIX)
+			  && add_into_largenumber(remainder, remainder,
+									  segment_view(&part, number->segments + low, low))
+			  && add_into_largenumber(twice, root, root)
+			  && divmod_largenumber(quotient, remainder, remainder, twice) == 1;
+
+	///The quotient fills the low segments of the root, and the square it adds is taken from
+	///the remainder, with the low segments of the number below it.
+	success = success
+			  && shift_largenumber(root, low * SEGMENT_RADIX)
+			  && add_into_largenumber(root, root, quotient)
+			  && shift_largenumber(remainder, low * SEGMENT_RADIX)
+			  && add_into_largenumber(remainder, remainder,
+									  segment_view(&part, number->segments, low))
+			  && sqr_into_largenumber(square, quotient)
+			  && sub_into_largenumber(remainder, remainder, square);
+
+	///A quotient one too large leaves the remainder negative, which is corrected by taking
+	///one from the root, adding 2 * root - 1 to the remainder.
+	if( success && remainder->sign == NEGATIVE){
+		success = add_into_largenumber(remainder, remainder, root)
+				  && sub_into_largenumber(root, root, value_largenumber(&holding,
+																		holding_segments, 1))
+				  && add_into_largenumber(remainder, remainder, root);
+	}
+
+	free_largenumber(quotient);
+	free_largenumber(twice);
+	free_largenumber(square);
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	root_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the root of a given degree of a large number, truncated towards zero.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number whose root is found.
+ |				degree,				The degree of the root, two giving the square root.
+ |	@return:	root,				The root, with the sign of the number.
+ |				NULL,				An error occured whilst allocating, the degree is zero,
+ |									or the degree is even and the number negative.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The root is found with newton's method, starting from the root of the
+ |				top of the number so each step works at about double the precision of the
+ |				last. The cost is a small multiple of raising a number to the degree.
+ |				Square roots are found with sqrt_largenumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* root_largenumber(large_number* number, unsigned int degree){
+	large_number* root, *power, magnitude;
+	largenumber_arena* previous;
+
+	if( degree == 0 || (number->sign == NEGATIVE && degree % 2 == 0)){
+		return NULL;
+	}
+	if( degree == 1 || (number->size == 1 && number->segments[0] <= 1)){
+		return copy_largenumber(number);
+	}
+	if( degree == 2){
+		return sqrt_largenumber(number, NULL);
+	}
+	///The root is found in numbers from the pool, then moved to any arena in use.
+	previous = use_largenumber_arena(NULL);
+	if( (power = init_largenumber(0)) == NULL){
+		return restore_arena(NULL, previous);
+	}
+
+	///The root of the magnitude is found, through a copy of the number with its sign cleared.
+	magnitude = *number;
+	magnitude.sign = POSITIVE;
+	if( (root = nth_root(&magnitude, degree, power)) != NULL){
+		root->sign = number->sign;
+		trim_largenumber(root);
+	}
+	free_largenumber(power);
+
+	return restore_arena(root, previous);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	sqrt_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the square root of a large number rounded down, and what is left.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number whose root is found, not negative.
+ |				remainder,			Where the number less the square of the root is stored, or
+ |									NULL if it is not needed. It may be the number.
+ |	@return:	root,				The root.
+ |				NULL,				An error occured whilst allocating, or the number is
+ |									negative.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The number is scaled by a power of four to be normalised, and its root
+ |				found with zimmermann's karatsuba square root, which recurses on the top
+ |				half of the number so each step works at double the precision of the last.
+ |				The cost is about that of dividing the number by its root.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* sqrt_largenumber(large_number* number, large_number* remainder){
+	large_number* root, *scaled, *scaled_remainder, *twice, holding;
+	segment holding_segments[3], low_bits, carry;
+	int shift = 0, success;
+	largenumber_arena* previous;
+
+	if( number->sign == NEGATIVE){
+		return NULL;
+	}
+	if( number->size == 1 && number->segments[0] <= 1){
+		if( remainder != NULL){
+			remainder->size = 1;
+			remainder->segments[0] = 0;
+			remainder->sign = POSITIVE;
+		}
+		return copy_largenumber(number);
+	}
+	previous = use_largenumber_arena(NULL);
+	if( (scaled = copy_largenumber(number)) == NULL){
+		return restore_arena(NULL, previous);
+	}
+
+	///The number is multiplied by four until it has an even amount of segments and a top
+	///segment of at least MAXVALUE / 4, which doubles the root each time.
+	while( scaled->size % 2 != 0 || scaled->segments[scaled->size - 1] < MAXVALUE / 4){
+		carry = multiply_segment(scaled->segments, scaled->segments, scaled->size, 4);
+		if( carry != 0){
+			if( !resize_largenumber(scaled, scaled->size + 1)){
+				free_largenumber(scaled);
+				return restore_arena(NULL, previous);
+			}
+			scaled->segments[scaled->size - 1] = carry;
+		}
+		shift++;
+	}
+
+	root = init_largenumber(0);
+	scaled_remainder = init_largenumber(0);
+	twice = init_largenumber(0);
+	success = root != NULL && scaled_remainder != NULL && twice != NULL
+			  && karatsuba_sqrt(root, scaled_remainder, scaled);
+
+	///The root is halved once per scaling. With t the bits taken off the root S, the
+	///remainder of the number is (R + t * (2S - t)) / 4^shift.
+	if( success && shift > 0){
+		success = add_into_largenumber(twice, root, root);
+		low_bits = divide_segment(root->segments, root->segments, root->size, 1U << shift);
+		trim_largenumber(root);
+		if( success && remainder != NULL){
+			success = sub_into_largenumber(twice, twice, unsigned_largenumber(&holding,
+																		 holding_segments,
+																		 low_bits))
+					  && multiply_into_largenumber(twice, twice, unsigned_largenumber(&holding,
+																				 holding_segments,
+																				 low_bits))
+					  && add_into_largenumber(scaled_remainder, scaled_remainder, twice);
+			if( success){
+				divide_segment(scaled_remainder->segments, scaled_remainder->segments,
+							   scaled_remainder->size, 1U << shift);
+				divide_segment(scaled_remainder->segments, scaled_remainder->segments,
+							   scaled_remainder->size, 1U << shift);
+				trim_largenumber(scaled_remainder);
+			}
+		}
+	}
+	if( success && remainder != NULL){
+		success = assign_largenumber(remainder, scaled_remainder);
+	}
+
+	free_largenumber(twice);
+	free_largenumber(scaled_remainder);
+	free_largenumber(scaled);
+	if( !success){
+		free_largenumber(root);
+		root = NULL;
+		return restore_arena(NULL, previous);
+	}
+
+	return restore_arena(root, previous);
+}
+
+/*
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ *	MODULAR ARITHMETIC FOR LARGE NUMBERS
+ === === === === === === === === === === === === === === === === === === === === === === ===
+ */
+
+#define MONTGOMERY_MAX_WINDOW	6			//Most exponent bits handled by one multiplication.
+#define EXPONENT_CHUNK_BITS		16			//Bits taken off an exponent per division.
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		largenumber_montgomery
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The values precomputed for multiplying modulo one modulus with
+ |				montgomery's method, with R = MAXVALUE^size.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		modulus, size,		The segments of the modulus and their amount.
+ |				r_squared,			R^2 modulo the modulus, used to convert into montgomery
+ |									form.
+ |				one,				R modulo the modulus, which is one in montgomery form.
+ |				inverse,			-modulus^-1 modulo MAXVALUE.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+struct largenumber_montgomery{
+	segment* modulus;
+	segment* r_squared;
+	segment* one;
+	size_t size;
+	segment inverse;
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	reduce_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds a segment array modulo another.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the modulus_size segment remainder is written.
+ |				number, size,		The array being reduced and its length.
+ |				modulus,			The modulus and its length, with its most significant
+ |				modulus_size,		segment not zero.
+ |	@return:	1,					The reduction was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int reduce_segments(segment* result, const segment* number, size_t size,
+						   const segment* modulus, size_t modulus_size){
+	segment* quotient;
+	size_t capacity;
+
+	size = trimmed_size(number, size);
+	if( compare_segments(number, size, modulus, modulus_size) < 0){
+		memset(result, 0, modulus_size * sizeof(segment));
+		memcpy(result, number, size * sizeof(segment));
+		return 1;
+	}
+	capacity = size - modulus_size + 1;
+	if( (quotient = alloc_segments(&capacity, NULL)) == NULL){
+		return 0;
+	}
+	if( !divide_segments(quotient, result, number, size, modulus, modulus_size)){
+		release_segments(quotient, capacity, NULL);
+		return 0;
+	}
+	release_segments(quotient, capacity, NULL);
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	reduce_base
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the residue of a number modulo a modulus, between zero and the
+ |				modulus.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the modulus_size segment residue is written.
+ |				number,				The number being reduced, which may be negative.
+ |				modulus,			The modulus and its length, with its most significant
+ |				modulus_size,		segment not zero.
+ |	@return:	1,					The reduction was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int reduce_base(segment* result, const large_number* number, const segment* modulus,
+					   size_t modulus_size){
+	if( !reduce_segments(result, number->segments, number->size, modulus, modulus_size)){
+		return 0;
+	}
+	///A negative number leaves a negative remainder, which is moved up by the modulus.
+	if( number->sign == NEGATIVE && trimmed_size(result, modulus_size) > 0){
+		sub_segments(result, modulus, modulus_size, result, modulus_size);
+	}
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	exponent_bits
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the binary digits of an exponent, in either radix.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		exponent,			The non negative exponent.
+ |				bit_count,			Where the amount of bits up to the highest one is written.
+ |	@return:	bits,				Every bit, least significant first, which must be freed.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The exponent is divided down EXPONENT_CHUNK_BITS bits at a time, which is
+ |				cheap next to the multiplications each bit costs.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static unsigned char* exponent_bits(const large_number* exponent, size_t* bit_count){
+	unsigned char* bits;					//Return value.
+	segment* dividing, chunk;
+	size_t size = trimmed_size(exponent->segments, exponent->size), count = 0;
+	int i;
+
+	if( (bits = malloc(32 * size + EXPONENT_CHUNK_BITS)) == NULL){
+		return NULL;
+	}
+	if( (dividing = malloc((size + 1) * sizeof(segment))) == NULL){
+		free(bits);
+		bits = NULL;
+		return NULL;
+	}
+	memcpy(dividing, exponent->segments, size * sizeof(segment));
+
+	while( size > 0){
+		chunk = divide_segment(dividing, dividing, size, 1U << EXPONENT_CHUNK_BITS);
+		for( i = 0; i < EXPONENT_CHUNK_BITS; i++){
+			bits[count++] = (chunk >> i) & 1;
+		}
+		size = trimmed_size(dividing, size);
+	}
+	while( count > 0 && bits[count - 1] == 0){
+		count--;
+	}
+	free(dividing);
+
+	*bit_count = count;
+	return bits;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	montgomery_inverse
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the negated inverse of a segment modulo MAXVALUE.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		low,				The lowest segment of the modulus.
+ |	@return:	-low^-1 modulo MAXVALUE, or zero if low has no inverse.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The inverse modulo RADIX_DIGIT is found by search, and then lifted with
+ |				newton's iteration, which doubles the amount of correct digits each step.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static segment montgomery_inverse(segment low){
+	unsigned long long inverse;
+	int i;
+
+	for( inverse = 1; inverse < RADIX_DIGIT; inverse++){
+		if( (low % RADIX_DIGIT) * inverse % RADIX_DIGIT == 1){
+			break;
+		}
+	}
+	if( inverse == RADIX_DIGIT){
+		return 0;
+	}
+	for( i = 0; i < 5; i++){
+		inverse = (2 + MAXVALUE - low * inverse % MAXVALUE) % MAXVALUE * inverse % MAXVALUE;
+	}
+	return (segment) ((MAXVALUE - inverse) % MAXVALUE);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	montgomery_multiply
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies two numbers in montgomery form, reducing the product as it is
+ |				built.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size segment product is written, may be either
+ |									of the numbers.
+ |				one, two,			The size segment numbers, both less than the modulus.
+ |				context,			The modulus and its precomputed values.
+ |				working,			Size + 1 segments of working space.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		For every segment of the first number, the second number times it and the
+ |				modulus times the value that clears the lowest segment are added in the same
+ |				pass, and the sum moved down a segment. The sum stays below twice the
+ |				modulus, so one subtraction at the end reduces it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void montgomery_multiply(segment* result, const segment* one, const segment* two,
+								const largenumber_montgomery* context, segment* working){
+	const segment* modulus = context->modulus;
+	unsigned long long product, reducing, carry_product, carry_reducing;
+	segment clearing;
+	size_t size = context->size, i, j;
+
+	memset(working, 0, (size + 1) * sizeof(segment));
+	for( i = 0; i < size; i++){
+		product = working[0] + (unsigned long long) one[i] * two[0];
+		clearing = (segment) (product % MAXVALUE * context->inverse % MAXVALUE);
+#if defined(LARGENUMBER_BINARY)
+		carry_product = product / MAXVALUE;
+		reducing = product % MAXVALUE + (unsigned long long) clearing * modulus[0];
+		carry_reducing = reducing / MAXVALUE;
+
+		for( j = 1; j < size; j++){
+			product = working[j] + (unsigned long long) one[i] * two[j] + carry_product;
+			carry_product = product / MAXVALUE;
+			reducing = product % MAXVALUE + (unsigned long long) clearing * modulus[j]
+					   + carry_reducing;
+			carry_reducing = reducing / MAXVALUE;
+			working[j-1] = (segment) (reducing % MAXVALUE);
+		}
+#else
+		//Both products fit in one 64 bit sum below base 10^9, so only one carry is divided out.
+		carry_product = 0;
+		carry_reducing = (product + (unsigned long long) clearing * modulus[0]) / MAXVALUE;
+
+		for( j = 1; j < size; j++){
+			reducing = working[j] + (unsigned long long) one[i] * two[j]
+					   + (unsigned long long) clearing * modulus[j] + carry_reducing;
+			carry_reducing = reducing / MAXVALUE;
+			working[j-1] = (segment) (reducing % MAXVALUE);
+		}
+#endif
+		product = working[size] + carry_product + carry_reducing;
+		working[size-1] = (segment) (product % MAXVALUE);
+		working[size] = (segment) (product / MAXVALUE);
+	}
+
+	if( working[size] != 0 || compare_segments(working, size, modulus, size) >= 0){
+		sub_segments(working, working, size + 1, modulus, size);
+	}
+	memcpy(result, working, size * sizeof(segment));
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_largenumber_montgomery
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Precomputes the values needed to multiply and raise numbers modulo a
+ |				modulus with montgomery's method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		modulus,			The modulus, whose sign is ignored, which must share no
+ |									factor with MAXVALUE, so it must be odd, and in the
+ |									base 10^9 build not a multiple of five.
+ |	@return:	context,			The precomputed values.
+ |				NULL,				The modulus is zero or shares a factor with MAXVALUE, or
+ |									an error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_montgomery* init_largenumber_montgomery(large_number* modulus){
+	largenumber_montgomery* context;		//Return value.
+	segment* power;
+	size_t size = trimmed_size(modulus->segments, modulus->size);
+	segment inverse;
+
+	if( size == 0 || (inverse = montgomery_inverse(modulus->segments[0])) == 0){
+		return NULL;
+	}
+	if( (context = malloc(sizeof(largenumber_montgomery))) == NULL){
+		return NULL;
+	}
+	context->size = size;
+	context->inverse = inverse;
+	context->modulus = malloc(3 * size * sizeof(segment));
+	power = calloc(2 * size + 1, sizeof(segment));
+	if( context->modulus == NULL || power == NULL){
+		free(power);
+		free(context->modulus);
+		free(context);
+		context = NULL;
+		return NULL;
+	}
+	context->r_squared = context->modulus + size;
+	context->one = context->r_squared + size;
+	memcpy(context->modulus, modulus->segments, size * sizeof(segment));
+
+	///R and R^2 are reduced from MAXVALUE^size and MAXVALUE^(2 * size).
+	power[size] = 1;
+	if( !reduce_segments(context->one, power, size + 1, context->modulus, size)){
+		free_largenumber_montgomery(context);
+		context = NULL;
+	}
+	else{
+		power[size] = 0;
+		power[2 * size] = 1;
+		if( !reduce_segments(context->r_squared, power, 2 * size + 1, context->modulus, size)){
+			free_largenumber_montgomery(context);
+			context = NULL;
+		}
+	}
+	free(power);
+
+	return context;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	free_largenumber_montgomery
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Frees the values precomputed for a modulus.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The precomputed values, may be NULL.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void free_largenumber_montgomery(largenumber_montgomery* context){
+	if( context == NULL){
+		return;
+	}
+	free(context->modulus);
+	free(context);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	montgomery_pow_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a number to a power modulo the modulus of a montgomery context.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The modulus and its precomputed values.
+ |				base,				The number being raised, which may be negative or larger
+ |									than the modulus.
+ |				exponent,			The power it is raised to.
+ |	@return:	powered,			The base raised to the exponent modulo the modulus, from
+ |									zero up to the modulus. A negative exponent gives zero.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The exponent is read from the top in windows of up to
+ |				MONTGOMERY_MAX_WINDOW bits, each starting and ending with a one, so each
+ |				window costs one multiplication by a precomputed odd power of the base.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* montgomery_pow_largenumber(largenumber_montgomery* context, large_number* base,
+										 large_number* exponent){
+	large_number* powered;					//Return value.
+	segment* odd_powers, *result, *working;
+	unsigned char* bits;
+	size_t size = context->size, bit_count, window, high, low, i;
+	unsigned int bits_value;
+
+	if( exponent->sign == NEGATIVE && trimmed_size(exponent->segments, exponent->size) > 0){
+		return init_largenumber(0);
+	}
+	if( (bits = exponent_bits(exponent, &bit_count)) == NULL){
+		return NULL;
+	}
+	window = bit_count > 671 ? 6 : bit_count > 239 ? 5 : bit_count > 79 ? 4
+			 : bit_count > 23 ? 3 : bit_count > 6 ? 2 : 1;
+	if( (odd_powers = malloc(((size_t) 1 << (window - 1)) * size * sizeof(segment))) == NULL
+	   || (result = malloc((2 * size + 1) * sizeof(segment))) == NULL){
+		free(odd_powers);
+		free(bits);
+		return NULL;
+	}
+	working = result + size;
+
+	///The base is reduced and put in montgomery form, and the odd powers found from its
+	///square.
+	if( !reduce_base(result, base, context->modulus, size)){
+		free(odd_powers);
+		free(result);
+		free(bits);
+		return NULL;
+	}
+	montgomery_multiply(odd_powers, result, context->r_squared, context, working);
+	montgomery_multiply(result, odd_powers, odd_powers, context, working);
+	for( i = 1; i < (size_t) 1 << (window - 1); i++){
+		montgomery_multiply(odd_powers + i * size, odd_powers + (i - 1) * size, result,
+							context, working);
+	}
+
+	///From the top, every zero bit squares the result, and every window of bits squares it
+	///once per bit and multiplies by its odd power.
+	memcpy(result, context->one, size * sizeof(segment));
+	for( high = bit_count; high > 0; high = low){
+		if( !bits[high - 1]){
+			low = high - 1;
+			bits_value = 0;
+		}
+		else{
+			for( low = high > window ? high - window : 0; !bits[low]; low++);
+			for( bits_value = 0, i = high; i > low; i--){
+				bits_value = bits_value << 1 | bits[i - 1];
+			}
+		}
+		for( i = low; i < high; i++){
+			montgomery_multiply(result, result, result, context, working);
+		}
+		if( bits_value != 0){
+			montgomery_multiply(result, result, odd_powers + (bits_value >> 1) * size,
+								context, working);
+		}
+	}
+
+	///Multiplying by a plain one takes the result out of montgomery form.
+	memset(odd_powers, 0, size * sizeof(segment));
+	odd_powers[0] = 1;
+	montgomery_multiply(result, result, odd_powers, context, working);
+	free(odd_powers);
+	free(bits);
+
+	if( (powered = init_sized_largenumber(size)) != NULL){
+		memcpy(powered->segments, result, size * sizeof(segment));
+		trim_largenumber(powered);
+	}
+	free(result);
+
+	return powered;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	powmod_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a number to a power modulo another number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		base,				The number being raised, which may be negative.
+ |				exponent,			The power it is raised to.
+ |				modulus,			The modulus, whose sign is ignored.
+ |	@return:	powered,			The base raised to the exponent modulo the modulus, from
+ |									zero up to the modulus. A negative exponent or a zero
+ |									modulus gives zero.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Moduli that share no factor with MAXVALUE use a montgomery context made
+ |				for the call, so many powers modulo one modulus are better found by keeping
+ |				a context from init_largenumber_montgomery. Any other modulus is reduced by
+ |				division after every multiplication.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* powmod_largenumber(large_number* base, large_number* exponent,
+								 large_number* modulus){
+	largenumber_montgomery* context;
+	large_number* powered = NULL, *reduced = NULL, *working = NULL, positive;
+	unsigned char* bits;
+	size_t size = trimmed_size(modulus->segments, modulus->size), bit_count, i;
+	int success = 1;
+	largenumber_arena* previous;
+
+	if( size == 0 || (exponent->sign == NEGATIVE
+					  && trimmed_size(exponent->segments, exponent->size) > 0)){
+		return init_largenumber(0);
+	}
+	if( (context = init_largenumber_montgomery(modulus)) != NULL){
+		powered = montgomery_pow_largenumber(context, base, exponent);
+		free_largenumber_montgomery(context);
+		return powered;
+	}
+
+	///Without a context, each step is a multiplication followed by a division, in numbers
+	///from the pool whatever arena is in use.
+	positive = *modulus;
+	positive.size = size;
+	positive.sign = POSITIVE;
+	if( (bits = exponent_bits(exponent, &bit_count)) == NULL){
+		return NULL;
+	}
+	previous = use_largenumber_arena(NULL);
+	if( (reduced = init_sized_largenumber(size)) == NULL
+	   || (working = init_sized_largenumber(2 * size)) == NULL
+	   || (powered = init_largenumber(1)) == NULL
+	   || !reduce_base(reduced->segments, base, positive.segments, size)
+	   || divmod_largenumber(NULL, powered, powered, &positive) != 1){
+		success = 0;
+	}
+	else{
+		trim_largenumber(reduced);
+	}
+	for( i = bit_count; success && i > 0; i--){
+		if( !sqr_into_largenumber(working, powered)
+		   || divmod_largenumber(NULL, powered, working, &positive) != 1
+		   || (bits[i - 1] && (!multiply_into_largenumber(working, powered, reduced)
+							   || divmod_largenumber(NULL, powered, working, &positive) != 1))){
+			success = 0;
+		}
+	}
+
+	free(bits);
+	free_largenumber(reduced);
+	free_largenumber(working);
+	if( !success){
+		free_largenumber(powered);
+		powered = NULL;
+		return restore_arena(NULL, previous);
+	}
+
+	return restore_arena(powered, previous);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:		largenumber_barrett
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The values precomputed for reducing numbers by one modulus with barrett's
+ |				method.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		modulus, size,		The segments of the modulus and their amount.
+ |				reciprocal,			MAXVALUE^(2 * size) divided by the modulus, and its
+ |				reciprocal_size,	amount of segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+struct largenumber_barrett{
+	segment* modulus;
+	segment* reciprocal;
+	size_t size;
+	size_t reciprocal_size;
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	barrett_scratch
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the amount of scratch segments barrett_segments needs.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The modulus and its precomputed values.
+ |	@return:	The amount of scratch segments needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t barrett_scratch(const largenumber_barrett* context){
+	return 3 * context->size + 2 + 2 * context->reciprocal_size;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	barrett_segments
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reduces a segment array below MAXVALUE^(2 * size) by the modulus of a
+ |				barrett context.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				Where the size segment residue is written, may be the
+ |									number.
+ |				number, size,		The array and its length, at most twice the moduli.
+ |				context,			The modulus and its precomputed values.
+ |				scratch,			At least barrett_scratch segments of working space.
+ |	@return:	1,					The reduction was a success.
+ |				0,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		The quotient is estimated by multiplying the top of the number by the
+ |				reciprocal, and is at most two below the true quotient, so the number less
+ |				the estimate times the modulus needs at most two more subtractions. Only
+ |				the low size + 1 segments of that difference are ever needed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int barrett_segments(segment* result, const segment* number, size_t size,
+							const largenumber_barrett* context, segment* scratch){
+	const segment* modulus = context->modulus;
+	size_t modulus_size = context->size, high_size, estimate_size, i;
+	segment* remaining = scratch, *estimate = remaining + modulus_size + 1, *product;
+
+	size = trimmed_size(number, size);
+	if( size < modulus_size){
+		memmove(result, number, size * sizeof(segment));
+		memset(result + size, 0, (modulus_size - size) * sizeof(segment));
+		return 1;
+	}
+
+	memset(remaining, 0, (modulus_size + 1) * sizeof(segment));
+	memcpy(remaining, number, (size < modulus_size + 1 ? size : modulus_size + 1) * sizeof(segment));
+
+	///The top of the number times the reciprocal, shifted down, estimates the quotient.
+	high_size = size - (modulus_size - 1);
+	if( !multiply_segments(estimate, number + modulus_size - 1, high_size,
+						   context->reciprocal, context->reciprocal_size)){
+		return 0;
+	}
+	if( high_size + context->reciprocal_size > modulus_size + 1){
+		estimate_size = high_size + context->reciprocal_size - (modulus_size + 1);
+		product = estimate + high_size + context->reciprocal_size;
+		estimate += modulus_size + 1;
+
+		///Below the karatsuba threshold, only the low segments of the product are found.
+		if( estimate_size < karatsuba_threshold){
+			product[modulus_size] = multiply_segment(product, modulus, modulus_size, estimate[0]);
+			for( i = 1; i < estimate_size && i <= modulus_size; i++){
+				addmul_segment(product + i, modulus, modulus_size + 1 - i, estimate[i]);
+			}
+		}
+		else if( !multiply_segments(product, estimate, estimate_size, modulus, modulus_size)){
+			return 0;
+		}
+		sub_segments(remaining, remaining, modulus_size + 1, product, modulus_size + 1);
+	}
+
+	while( compare_segments(remaining, trimmed_size(remaining, modulus_size + 1),
+							modulus, modulus_size) >= 0){
+		sub_segments(remaining, remaining, modulus_size + 1, modulus, modulus_size);
+	}
+	memcpy(result, remaining, modulus_size * sizeof(segment));
+
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_largenumber_barrett
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Precomputes the reciprocal of a modulus, so numbers can be reduced by it
+ |				with multiplications alone.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		modulus,			The non zero modulus, whose sign is ignored.
+ |	@return:	context,			The precomputed values.
+ |				NULL,				The modulus is zero, or an error occured whilst
+ |									allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+largenumber_barrett* init_largenumber_barrett(large_number* modulus){
+	largenumber_barrett* context;			//Return value.
+	segment* power, *remainder;
+	size_t size = trimmed_size(modulus->segments, modulus->size);
+	int success;
+
+	if( size == 0 || (context = malloc(sizeof(largenumber_barrett))) == NULL){
+		return NULL;
+	}
+	context->size = size;
+	context->modulus = malloc((2 * size + 2) * sizeof(segment));
+	power = calloc(3 * size + 1, sizeof(segment));
+	if( context->modulus == NULL || power == NULL){
+		free(power);
+		free(context->modulus);
+		free(context);
+		context = NULL;
+		return NULL;
+	}
+	context->reciprocal = context->modulus + size;
+	remainder = power + 2 * size + 1;
+	memcpy(context->modulus, modulus->segments, size * sizeof(segment));
+
+	power[2 * size] = 1;
+	success = divide_segments(context->reciprocal, remainder, power, 2 * size + 1,
+							  context->modulus, size);
+	context->reciprocal_size = trimmed_size(context->reciprocal, size + 2);
+	free(power);
+	if( !success){
+		free_largenumber_barrett(context);
+		context = NULL;
+		return NULL;
+	}
+
+	return context;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	free_largenumber_barrett
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Frees the reciprocal precomputed for a modulus.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The precomputed values, may be NULL.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void free_largenumber_barrett(largenumber_barrett* context){
+	if( context == NULL){
+		return;
+	}
+	free(context->modulus);
+	free(context);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	barrett_mod_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reduces a large number by the modulus of a barrett context.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The modulus and its precomputed reciprocal.
+ |				number,				The number being reduced.
+ |	@return:	remainder,			The remainder, with the sign of the number, as with
+ |									mod_two_largenumbers.
+ |				NULL,				An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+large_number* barrett_mod_largenumber(largenumber_barrett* context, large_number* number){
+	large_number* remainder;				//Return value.
+
+	if( (remainder = init_sized_largenumber(context->size)) == NULL){
+		return NULL;
+	}
+	if( !barrett_mod_into_largenumber(context, remainder, number)){
+		free_largenumber(remainder);
+		remainder = NULL;
+		return NULL;
+	}
+
+	return remainder;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	barrett_mod_into_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reduces a large number by the modulus of a barrett context, storing the
+ |				remainder in a given number whose storage is reused.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		context,			The modulus and its precomputed reciprocal.
+ |				remainder,			Where the remainder is stored, may be the number.
+ |				number,				The number being reduced.
+ |	@return:	1,					The reduction was a success.
+ |				0,					An error occured whilst allocating, the remainder is
+ |									unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Numbers over twice the length of the modulus are reduced a modulus length
+ |				at a time from the top, with the remainder so far above each part.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int barrett_mod_into_largenumber(largenumber_barrett* context, large_number* remainder,
+								 large_number* number){
+	segment* scratch, *reducing;
+	size_t size = context->size, capacity = barrett_scratch(context) + 2 * size, position, length;
+	char sign = number->sign;
+	int success = 1;
+
+	if( (scratch = alloc_segments(&capacity, NULL)) == NULL){
+		return 0;
+	}
+	reducing = scratch + barrett_scratch(context);
+
+	///The top part is reduced on its own, then every part below is reduced with the
+	///remainder above it, which keeps each below the modulus times MAXVALUE^size.
+	position = number->size;
+	length = number->size <= 2 * size ? number->size : (number->size - 1) % size + 1;
+	position -= length;
+	success = barrett_segments(reducing + size, number->segments + position, length, context,
+							   scratch);
+	while( success && position > 0){
+		position -= size;
+		memcpy(reducing, number->segments + position, size * sizeof(segment));
+		success = barrett_segments(reducing + size, reducing, 2 * size, context, scratch);
+	}
+
+	if( success && (success = resize_largenumber(remainder, size))){
+		memcpy(remainder->segments, reducing + size, size * sizeof(segment));
+		remainder->sign = sign;
+		clear_decimals(remainder);
+		trim_largenumber(remainder);
+	}
+	release_segments(scratch, capacity, NULL);
+
+	return success;
+}
+
+#define GCD_THRESHOLD			120			//Default segments before the half gcd is used.
+#define LEHMER_LIMIT			(1LL << 62)	//Bound on the approximations and their matrix.
+
+static size_t gcd_threshold = GCD_THRESHOLD;
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Type:	gcd_matrix
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The product of the reduction steps taken on a pair of numbers, so that the
+ |				original pair is the matrix times the reduced pair.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		entries,			The four entries, never negative. Every step has a
+ |									determinant of one, so the product does too.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+typedef struct gcd_matrix{
+	large_number* entries[2][2];
+} gcd_matrix;
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	init_segment
+ |	Type:	gcd_state
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Initialise function for a segment in a large number.
+ |	Purpose:	A pair of numbers being reduced towards their greatest common divisor.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		value_segment		The value the head segment will be set to.
- |	@return:	segment_making,		The initialisation was a success.
- |				NULL,				Allocation of memory failed, intialisation unsuccessful.
+ |	Fields:		one, two,			The pair, never negative.
+ |				matrix,				The steps taken so far, or NULL if they are not needed.
+ |				working,			Numbers whose storage is reused by every step.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-segment* init_segment(unsigned int value_segment){
-	segment* making_segment;
-	
-	/// Allocates memory for segment and sets it to the given value.
-	if( (making_segment = malloc(sizeof(segment))) == NULL){
-		return NULL;						//Allocation failed, return error value.
+typedef struct gcd_state{
+	large_number* one, *two;
+	gcd_matrix* matrix;
+	large_number* working[4];
+} gcd_state;
+
+static int half_gcd(gcd_state* state);
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	number_size
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the amount of segments a large number uses, with zero using none.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number being measured.
+ |	@return:	The amount of segments without leading zeros.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static size_t number_size(const large_number* number){
+	return trimmed_size(number->segments, number->size);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	free_gcd_matrix
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Frees the entries of a matrix.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		matrix,				The matrix being freed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void free_gcd_matrix(gcd_matrix* matrix){
+	int row, column;
+
+	for( row = 0; row < 2; row++){
+		for( column = 0; column < 2; column++){
+			free_largenumber(matrix->entries[row][column]);
+			matrix->entries[row][column] = NULL;
+		}
 	}
-	making_segment->value = value_segment % MAXVALUE;
-	making_segment->next = NULL;					//Set the default to having no next.
-	making_segment->prev = NULL;					//Set by default to having no previous.
-	
-	return making_segment;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Subroutine:	free_largenumber
+ |	Function:	init_gcd_matrix
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	To free all allocated memory used in a large number.
+ |	Purpose:	Sets up a matrix as the identity, which takes no steps.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		deleting_largenumber	The large number which will be deleted.
+ |	@param:		matrix,				The matrix being set up.
+ |	@return:	1,					The matrix was set up.
+ |				0,					An error occured whilst allocating, nothing is left
+ |									allocated.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-void free_largenumber(large_number* deleting_largenumber){
-	segment* conductor = NULL, *todelete;
-	
-	///If the large number has any segments, they are all freed.
-	if( (todelete = deleting_largenumber->head) != NULL){
-		///Starting from the head, every segment in the large number is visited, and the
-		///previous one is stored, then freed. Once the end is reached the last element is
-		///freed.
-		conductor = todelete->next;
-		
-		while( conductor != NULL){
-			free(todelete);
-			todelete = conductor;
-			
-			conductor = conductor->next;
+static int init_gcd_matrix(gcd_matrix* matrix){
+	int row, column;
+
+	for( row = 0; row < 2; row++){
+		for( column = 0; column < 2; column++){
+			matrix->entries[row][column] = init_largenumber(row == column);
 		}
-		free(todelete);						//Last element otherwise would not be freed.
-		todelete = NULL;
 	}
-	//Memory allocated for large number itself is freed and set to null.
-	free(deleting_largenumber);
-	deleting_largenumber = NULL;
+	for( row = 0; row < 2; row++){
+		for( column = 0; column < 2; column++){
+			if( matrix->entries[row][column] == NULL){
+				free_gcd_matrix(matrix);
+				return 0;
+			}
+		}
+	}
+	return 1;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	init_largenumber
- -- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Initialise function for a large number.
+ |	Subroutine:	free_gcd_state
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		value_number		The value the number will be set to.
- |	@return:	largenumber_making	The initialisation was a success.
- |				NULL,				Allocation of memory failed, intialisation unsuccessful.
+ |	Purpose:	Frees the numbers of a state, leaving its matrix.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		state,				The state being freed.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* init_largenumber(long long value_number){
-	large_number* making_largenumber;
-	segment* setting_segment, *conductor;
-	
-	///Allocates memory for the entire number, then allocates memory for the first
-	if( (making_largenumber = malloc(sizeof(large_number))) == NULL){
-		return NULL;						//Allocation failed, return error value
+static void free_gcd_state(gcd_state* state){
+	int i;
+
+	free_largenumber(state->one);
+	free_largenumber(state->two);
+	state->one = state->two = NULL;
+	for( i = 0; i < 4; i++){
+		free_largenumber(state->working[i]);
+		state->working[i] = NULL;
 	}
-	
-	if( value_number >= POSITIVE){
-		making_largenumber->sign = POSITIVE;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	init_gcd_state
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets up a pair of numbers to be reduced.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		state,				The state being set up.
+ |				one, two,			The numbers, whose signs are ignored.
+ |				segments,			The amount of leading segments that are left out of
+ |									each number, so only its top part is reduced.
+ |				matrix,				The matrix the steps are gathered in, or NULL.
+ |	@return:	1,					The state was set up.
+ |				0,					An error occured whilst allocating, nothing is left
+ |									allocated.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int init_gcd_state(gcd_state* state, const large_number* one, const large_number* two,
+						  size_t segments, gcd_matrix* matrix){
+	const large_number* numbers[2] = { one, two };
+	large_number* copies[2];
+	size_t size;
+	int i, success = 1;
+
+	for( i = 0; i < 2; i++){
+		size = number_size(numbers[i]) > segments ? number_size(numbers[i]) - segments : 0;
+		if( (copies[i] = init_sized_largenumber(size)) != NULL){
+			memcpy(copies[i]->segments, numbers[i]->segments + segments, size * sizeof(segment));
+		}
 	}
-	else{
-		making_largenumber->sign = NEGATIVE;
-		value_number = -value_number;
+	state->one = copies[0];
+	state->two = copies[1];
+	state->matrix = matrix;
+	for( i = 0; i < 4; i++){
+		state->working[i] = init_largenumber(0);
 	}
-	
-	if( (setting_segment = init_segment(value_number % MAXVALUE)) == NULL){
-		///Allocation failed, free all allocated values and return error value.
-		free(making_largenumber);
-		making_largenumber = NULL;
-		return NULL;
+	if( state->one == NULL || state->two == NULL){
+		success = 0;
 	}
-	making_largenumber->head = setting_segment;
-	making_largenumber->tail = making_largenumber->head;
-	
-	conductor = making_largenumber->head;
-	
-	while( ( (unsigned long long) (value_number /= MAXVALUE)) > 0){
-		if( (setting_segment = init_segment(value_number % MAXVALUE)) == NULL){
-			///Allocation failed, free all allocated values and return error value.
-			free_largenumber(making_largenumber);
-			making_largenumber = NULL;
-			return NULL;
+	for( i = 0; i < 4; i++){
+		if( state->working[i] == NULL){
+			success = 0;
 		}
-		conductor->next = setting_segment;
-		setting_segment->prev = conductor;
-		
-		making_largenumber->tail = setting_segment;
 	}
-	
-	making_largenumber->max_dec_places = 0;	//No decimals are allowed by default.
-	
-	return making_largenumber;
+	if( !success){
+		free_gcd_state(state);
+	}
+	return success;
 }
 
-
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Subroutine:	fprint_largenumber
+ |	Function:	multiply_gcd_matrix
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Initialise print the contents of a large number to a stream in base ten.
+ |	Purpose:	Adds the steps of one matrix onto another, by multiplying them.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		toprint_number,		The large number to be displayed to the given stream.
- |				stream,				Where the number will be displayed to.
+ |	@param:		matrix,				The matrix the steps are added to, which is replaced by
+ |									matrix times steps.
+ |				steps,				The steps taken after those of the matrix.
+ |				working,			Two numbers whose storage is reused.
+ |	@return:	1,					The multiplication was a success.
+ |				0,					An error occured whilst allocating.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-void fprint_largenumber(FILE* stream, large_number *toprint_number){
-	segment* conductor = toprint_number->tail;
-	int toprint_digit, sigfig, counter = 1;
-	
-	if(conductor != NULL){
-		fprintf(stream, "\n");
-		if( toprint_number-> sign == NEGATIVE){
-			fprintf(stream, "-");
-		}
-		fprintf(stream, "%u", conductor->value);
-		conductor = conductor->prev;
-	}
-	
-	while( conductor != NULL){
-		if(counter == toprint_number->decimal_position){
-			fprintf(stream, ".");
+static int multiply_gcd_matrix(gcd_matrix* matrix, large_number* const steps[2][2],
+							   large_number** working){
+	large_number* swapper;
+	int row, column;
+
+	for( row = 0; row < 2; row++){
+		for( column = 0; column < 2; column++){
+			if( !multiply_into_largenumber(working[column], matrix->entries[row][0],
+										   steps[0][column])
+			   || !multiply_into_largenumber(working[2], matrix->entries[row][1],
+											 steps[1][column])
+			   || !add_into_largenumber(working[column], working[column], working[2])){
+				return 0;
+			}
 		}
-		for( sigfig = MAXVALUE; sigfig > 0; sigfig /= 10){
-			toprint_digit = conductor->value / sigfig;
-			fprintf(stream, "%d", toprint_digit);
+		///The row is only replaced once both of its new entries are found.
+		for( column = 0; column < 2; column++){
+			swapper = matrix->entries[row][column];
+			matrix->entries[row][column] = working[column];
+			working[column] = swapper;
 		}
-		
-		conductor = conductor->prev;
 	}
-	
-	fprintf(stream, "\n");
+	return 1;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Subroutine:	print_largenumber
+ |	Function:	apply_gcd_steps
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Initialise print the contents of a large number to screen in base ten,
- |				shorthand for the fprint_largenumber function.
+ |	Purpose:	Reduces a pair of numbers by the steps of a matrix, if the reduced pair
+ |				is still large enough.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		toprint_number		The large number to be displayed to the given stream.
+ |	@param:		state,				The pair being reduced.
+ |				steps,				The steps, the reduced pair being the inverse of the
+ |									steps times the pair.
+ |				bound,				The reduced numbers, and their difference, must use more
+ |									than this amount of segments, unless it is zero.
+ |	@return:	1,					The pair was reduced, and the steps added to its matrix.
+ |				0,					The reduced pair would be negative or too small, so the
+ |									pair is unchanged.
+ |				-1,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		With a determinant of one, the inverse of (a b; c d) is (d -b; -c a).
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-void print_largenumber(large_number *toprint_number){
-	fprint_largenumber(stdout, toprint_number);
+static int apply_gcd_steps(gcd_state* state, large_number* const steps[2][2], size_t bound){
+	large_number** working = state->working, *swapper;
+
+	if( !multiply_into_largenumber(working[0], steps[1][1], state->one)
+	   || !multiply_into_largenumber(working[1], steps[0][1], state->two)
+	   || !sub_into_largenumber(working[0], working[0], working[1])
+	   || !multiply_into_largenumber(working[1], steps[0][0], state->two)
+	   || !multiply_into_largenumber(working[2], steps[1][0], state->one)
+	   || !sub_into_largenumber(working[1], working[1], working[2])){
+		return -1;
+	}
+
+	///Steps found from part of a number are checked against the whole number.
+	if( working[0]->sign == NEGATIVE || working[1]->sign == NEGATIVE){
+		return 0;
+	}
+	if( bound > 0){
+		if( !sub_into_largenumber(working[2], working[0], working[1])){
+			return -1;
+		}
+		if( number_size(working[0]) <= bound || number_size(working[1]) <= bound
+		   || number_size(working[2]) <= bound){
+			return 0;
+		}
+	}
+
+	swapper = state->one;
+	state->one = working[0];
+	working[0] = swapper;
+	swapper = state->two;
+	state->two = working[1];
+	working[1] = swapper;
+	if( state->matrix != NULL && !multiply_gcd_matrix(state->matrix, steps, working)){
+		return -1;
+	}
+	return 1;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Subroutine:	print_largenumber
+ |	Function:	top_approximation
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Initialise print the contents of a large number to screen in base ten.
+ |	Purpose:	Finds the top two segments of a number as a single value, taking the
+ |				number to be a given amount of segments long.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		toprint_number		The large number to be displayed to the given stream.
- |	@return:	1,					The initialisation was a success.
- |				0,					Allocation of memory failed, intialisation unsuccessful.
+ |	@param:		number,				The number being approximated.
+ |				size,				The length it is taken to have, at least two.
+ |	@return:	The approximation, below LEHMER_LIMIT.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-extern large_number* stolargenumber(char* number_string){
-	large_number* number;					//Return value.
-	segment* made_segment;					//Used to add segments to the large number.
-	int number_pointer, char_pointer;
-	char* holding;
-	unsigned int converting;
-	int i;									//loop control.
-	
-	if( (holding = calloc(10, sizeof(char))) == NULL){
-		return NULL;
-	}
-	
-	if( (number = init_largenumber(0)) == NULL){
-		free(holding);
-		holding = NULL;
-		return NULL;						//Allocation failed, return error value.
-	}
-	number_pointer = 8;
-	
-	///Goes through all the characters from the end. If they are a number value, they
-	///are added to 
-	for(char_pointer = strlen(number_string) - 1; char_pointer >= 0; char_pointer--){
-		if( number_string[char_pointer] <= '9' || number_string[char_pointer] >= '0'){
-			holding[number_pointer] = number_string[char_pointer];
-			number_pointer--;
-		}
-		
-		///Updates the number pointer, and if the holding string is full, it will produce a
-		///new segment and add it to the end of the large number, then clear the array.
-		if( number_pointer < 0){
-			converting = 0;
-			for( i = 0; i <= 8; i++){
-				converting *= 10;
-				converting += holding[i] - '0';
-			}
-			fprintf(stdout, "\nOSTRING:\t%s\n",number_string);
-			fprintf(stdout, "\nHSTRING:\t%s\n",holding);
-			fprintf(stdout, "\nNUMBER:\t%d\n",converting);
-			number->tail->value = converting;
-			if(char_pointer != 0){			
-				if( (made_segment = init_segment(0)) == NULL){
-					///Allocation failed, free all allocated memory and return error value.
-					free(holding);
-					holding = NULL;
-					free_largenumber(number);
-					number = NULL;
-					return NULL;
-				}
-				puts("");
-				number->tail->next = made_segment;
-				made_segment->prev = number->tail;
-				number->tail = made_segment;
-				
-			}
-			memset(holding, '\0',strlen(holding));
-			number_pointer = 8;
-		}
-	}
-	
-	///Under the case that a partial number is held after all characters are read, a number
-	///is produced and added to the end of the list.
-	if( number_pointer != 8){
-		converting = 0;
-		for( i = number_pointer+1; i <= 8; i++){
-			converting *= 10;
-			converting += holding[i] - '0';
-			printf("\nCONVERTING:%d\n",holding[i] - '0');
-		}
-		number->tail->value = converting;
-	}
-	
-	free(holding);
-	holding = NULL;
-	return number;
+static long long top_approximation(const large_number* number, size_t size){
+	unsigned long long high = size <= number->size ? number->segments[size - 1] : 0;
+	unsigned long long low = size - 1 <= number->size ? number->segments[size - 2] : 0;
+
+#if defined(LARGENUMBER_BINARY)
+	//Two segments in base 2^32 fill 64 bits, so the lowest two are dropped from both numbers.
+	return (long long) ((high * MAXVALUE + low) >> 2);
+#else
+	return (long long) (high * MAXVALUE + low);
+#endif
 }
 
 /*
- === === === === === === === === === === === === === === === === === === === === === === ===
- *	MATH FUNCTIONS FOR LARGE NUMBERS
- === === === === === === === === === === === === === === === === === === === === === === ===
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	lehmer_steps
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds as many of the next reduction steps of a pair as can be told from
+ |				the top two segments of each number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		state,				The pair being reduced, of which the larger number uses at
+ |									least two segments.
+ |				steps,				Where the steps are written, as a matrix.
+ |	@return:	The amount of steps found.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		With the approximations being the numbers divided by some X and rounded
+ |				down, the reduced numbers divided by X lie within the matrix entries of the
+ |				reduced approximations. A quotient is only taken when it is the same at
+ |				both ends of those ranges, so it is always the true quotient.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
+static int lehmer_steps(const gcd_state* state, long long steps[2][2]){
+	size_t size = number_size(state->one) > number_size(state->two)
+				  ? number_size(state->one) : number_size(state->two);
+	long long one = top_approximation(state->one, size), two = top_approximation(state->two, size);
+	long long quotient;
+	int count = 0;
+
+	steps[0][0] = steps[1][1] = 1;
+	steps[0][1] = steps[1][0] = 0;
+	for( ;; count++){
+		if( one >= two){
+			if( two - steps[1][0] <= 0 || one - steps[0][1] < 0){
+				break;
+			}
+			quotient = (one - steps[0][1]) / (two + steps[0][0]);
+			if( quotient == 0 || quotient != (one + steps[1][1]) / (two - steps[1][0])
+			   || quotient > (LEHMER_LIMIT - steps[0][1]) / steps[0][0]
+			   || (steps[1][0] > 0 && quotient > (LEHMER_LIMIT - steps[1][1]) / steps[1][0])){
+				break;
+			}
+			one -= quotient * two;
+			steps[0][1] += quotient * steps[0][0];
+			steps[1][1] += quotient * steps[1][0];
+		}
+		else{
+			if( one - steps[0][1] <= 0 || two - steps[1][0] < 0){
+				break;
+			}
+			quotient = (two - steps[1][0]) / (one + steps[1][1]);
+			if( quotient == 0 || quotient != (two + steps[0][0]) / (one - steps[0][1])
+			   || (steps[0][1] > 0 && quotient > (LEHMER_LIMIT - steps[0][0]) / steps[0][1])
+			   || quotient > (LEHMER_LIMIT - steps[1][0]) / steps[1][1]){
+				break;
+			}
+			two -= quotient * one;
+			steps[0][0] += quotient * steps[0][1];
+			steps[1][0] += quotient * steps[1][1];
+		}
+	}
+	return count;
+}
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	add_largenumber
+ |	Function:	division_step
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Add a single value to a large number.
+ |	Purpose:	Reduces the larger number of a pair by the smaller with one division.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		number,				The number that will be added to.
- |				value_adding,		The value that will be added to the number.
- |	@return:	sum,				The number of the value and large number added together.
- |				0,					An error occured whilst adding a segment.
+ |	@param:		state,				The pair being reduced.
+ |				bound,				The reduced number must use more than this amount of
+ |									segments, unless it is zero.
+ |	@return:	1,					The pair was reduced.
+ |				0,					The pair can not be reduced within the bound, or the
+ |									smaller number is zero.
+ |				-1,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		When the remainder is too small, one less multiple of the smaller number
+ |				is taken away instead, as long as that is still a reduction.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* add_largenumber(large_number* number, int value_adding){
-	large_number* sum;						//Return value.
-	segment* conductor, *made_segment;
-	unsigned long long carry;
-	
-	if( (sum = init_largenumber(0)) == NULL){
-		return NULL;						//Allocation failed, return error value.
+static int division_step(gcd_state* state, size_t bound){
+	large_number** working = state->working, *swapper, *larger, *smaller;
+	large_number* quotient = working[0], *remainder = working[1];
+	large_number one_value;
+	segment one_segments[3];
+	int reducing_one = compare_segments(state->one->segments, state->one->size,
+										state->two->segments, state->two->size) >= 0;
+	int column;
+
+	larger = reducing_one ? state->one : state->two;
+	smaller = reducing_one ? state->two : state->one;
+	if( number_size(smaller) <= bound){
+		return 0;
 	}
-	sum->sign = number->sign;
-	
-	///Does a subtraction operation if more appripriate based on the signs.
-	if( sum->sign == POSITIVE && value_adding < 0){
-		free_largenumber(sum);
-		sum = NULL;
-		return sub_largenumber(number, -value_adding);
+	if( bound > 0){
+		if( !sub_into_largenumber(remainder, larger, smaller)){
+			return -1;
+		}
+		if( number_size(remainder) <= bound){
+			return 0;
+		}
+	}
+
+	if( divmod_largenumber(quotient, remainder, larger, smaller) != 1){
+		return -1;
 	}
-	else if( sum->sign == NEGATIVE){
-		if( value_adding > 0){
-			free_largenumber(sum);
-			sum = NULL;
-			return sub_largenumber(number,value_adding);
+	if( bound > 0 && number_size(remainder) <= bound){
+		value_largenumber(&one_value, one_segments, 1);
+		if( !add_into_largenumber(remainder, remainder, smaller)
+		   || !sub_into_largenumber(quotient, quotient, &one_value)){
+			return -1;
 		}
-		else{
-			value_adding = -value_adding;
-		}
-	}
-	carry = (unsigned long long) value_adding;
-	conductor = number->head;
-	while(1){
-		if( conductor != NULL){
-			carry += conductor->value;
-			conductor = conductor->next;
-		}
-		//Sets the last value of the sum to hold the maximum allowed value of adding value.
-		sum->tail->value = carry % MAXVALUE;
-		carry /= MAXVALUE;
-		
-		if( carry > 0 || conductor != NULL){
-			///Adds a new blank segment to the end of the large number.
-			if( (made_segment = init_segment(0)) == NULL){
-				//Allocation failed, free allocated memory and return error value.
-				free_largenumber(sum);
-				number = NULL;
-				return NULL;
-			}
-			sum->tail->next = made_segment;
-			made_segment->prev = sum->tail;
-			sum->tail = made_segment;
+	}
 
-			continue;
+	///The larger number is replaced by the remainder, and the quotient taken into the
+	///matrix as the step (1 q; 0 1) or (1 0; q 1).
+	if( reducing_one){
+		swapper = state->one;
+		state->one = remainder;
+	}
+	else{
+		swapper = state->two;
+		state->two = remainder;
+	}
+	working[1] = swapper;
+	if( state->matrix != NULL){
+		column = reducing_one ? 0 : 1;
+		if( !multiply_into_largenumber(working[2], quotient, state->matrix->entries[0][column])
+		   || !add_into_largenumber(state->matrix->entries[0][1 - column],
+									state->matrix->entries[0][1 - column], working[2])
+		   || !multiply_into_largenumber(working[2], quotient, state->matrix->entries[1][column])
+		   || !add_into_largenumber(state->matrix->entries[1][1 - column],
+									state->matrix->entries[1][1 - column], working[2])){
+			return -1;
 		}
-		else break;
 	}
-	
-	return sum;
+	return 1;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	add_two_largenumbers
+ |	Function:	reduce_step
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Add a single value to a large number.
+ |	Purpose:	Takes the next reduction steps of a pair, with lehmer's method if they can
+ |				be found from the top of the numbers, otherwise with a division.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		number_one,			The first part of the addition.
- |				number_two,			The second part of the addition.
- |	@return:	sum,				The value of the two large numbers added.
- |				NULL,				An error occured whilst adding a segment.
+ |	@param:		state,				The pair being reduced.
+ |				bound,				The reduced numbers must use more than this amount of
+ |									segments, unless it is zero.
+ |	@return:	1,					The pair was reduced.
+ |				0,					The pair can not be reduced within the bound.
+ |				-1,					An error occured whilst allocating.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* add_two_largenumbers(large_number* number_one,large_number* number_two){
-	large_number* sum;						//Return value.
-	segment* conductor_one, *conductor_two, *made_segment;
-	unsigned long long value_adding = 0;
-	
-	///Checks if a subtraction operation would be more appropriate given the signs.
-	if( number_one->sign != number_two->sign){
-		//sub_two_largenumbers(number_one, number_two);
-	}
-	
-	///Sets the head of the sum to the sum of the first two segments in the given numbers.
-	conductor_one = number_one->head;
-	conductor_two = number_two->head;
-	
-	if( conductor_one != NULL){
-		value_adding += (unsigned long long) conductor_one->value;
-		conductor_one = conductor_one->next;
-	}
-	if( conductor_two != NULL){
-		value_adding += (unsigned long long) conductor_two->value;
-		conductor_two = conductor_two->next;
-	}
-	if( (sum = init_largenumber(value_adding % MAXVALUE)) == NULL){
-		return NULL;
-	}
-	value_adding /= MAXVALUE;
-	
-	//Until all the segments in both numbers are visited, and all values to be carried are
-	//Added to the large number, a new segment is created and added to the sum, and it takes
-	//the value of the two large numbers added, plus the carry, modded by one billion.
-	while(conductor_one != NULL || conductor_two != NULL || value_adding > 0){
-		//Creates a blank segment and adds it to the end of the large number.
-		if((made_segment = init_segment(0)) == NULL){
-			free_largenumber(sum);
-			sum = NULL;
-			return NULL;
+static int reduce_step(gcd_state* state, size_t bound){
+	long long steps[2][2];
+	large_number step_values[2][2];
+	large_number* step_numbers[2][2];
+	segment step_segments[2][2][3];
+	int row, column, result;
+
+	if( (number_size(state->one) > 1 || number_size(state->two) > 1)
+	   && lehmer_steps(state, steps) > 0){
+		for( row = 0; row < 2; row++){
+			for( column = 0; column < 2; column++){
+				step_numbers[row][column] = value_largenumber(&step_values[row][column],
+															  step_segments[row][column],
+															  steps[row][column]);
+			}
+		}
+		if( (result = apply_gcd_steps(state, step_numbers, bound)) != 0){
+			return result;
 		}
-		sum->tail->next = made_segment;
-		made_segment->prev = sum->tail;
-		sum->tail = made_segment;
-		
-		//The value the the current section will be is calculated by adding the prevous
-		//carry value, and the two current segments (if valid).
-		if( conductor_one != NULL){
-			value_adding += (unsigned long long) conductor_one->value;
-			conductor_one = conductor_one->next;
-		}
-		if( conductor_two != NULL){
-			value_adding += (unsigned long long) conductor_two->value;
-			conductor_two = conductor_two->next;
-		}
-		//Tail value is set, and the carry value is produced.
-		sum->tail->value = value_adding % MAXVALUE;
-		
-		value_adding /= MAXVALUE;
 	}
-	
-	return sum;
+	return division_step(state, bound);
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	sub_largenumber
+ |	Function:	recurse_gcd
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Subtracts a value from a large number.
+ |	Purpose:	Reduces a pair by the steps the half gcd finds for the top part of each
+ |				number.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		number,				The number that will be minused from.
- |				value_negate,		The value that will be negated from the large number.
- |	@return:	negated,			The negated value.
- |				NULL,				An error occured whilst adding a segment.
+ |	@param:		state,				The pair being reduced.
+ |				segments,			The amount of low segments left out of the top parts.
+ |				bound,				The reduced numbers must use more than this amount of
+ |									segments, unless it is zero.
+ |	@return:	1,					The pair was reduced.
+ |				0,					No steps were found, or they would reduce the pair too
+ |									far.
+ |				-1,					An error occured whilst allocating.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* sub_largenumber(large_number* number, int value_negate){
-	large_number* negated;					//Return value;
-	segment* cond, *made_segment;
-	char satisfied = 0;
-	
-	if( (negated = init_largenumber(0)) == NULL){
-		return NULL;						//Allocation failed, return error value.
+static int recurse_gcd(gcd_state* state, size_t segments, size_t bound){
+	gcd_matrix steps;
+	gcd_state top;
+	int result;
+
+	if( !init_gcd_matrix(&steps)){
+		return -1;
 	}
-	//Sets the sign to the correct value.
-	negated->sign = number->sign;
-	
-	//Chooses an addition operation if more appropriate.
-	if( (number->sign == POSITIVE)&&(value_negate < 0)){
-		free_largenumber(negated);
-		negated = NULL;
-		return add_largenumber(number, (long) -1 * value_negate);
-	}
-	if(number->sign == NEGATIVE){
-		if( value_negate > 0){
-			free_largenumber(negated);
-			negated = NULL;
-			return add_largenumber(number, -value_negate);
-		}
-		value_negate = -value_negate;
-	}
-	cond = number->head;
-	if( cond->value >= value_negate){
-		negated->head->value = cond->value - value_negate;
-		
-		for(cond = cond->next; cond != NULL; cond = cond->next){
-			if( (made_segment = init_segment(cond->value)) == NULL){
-				///Allocation failed, free allocated variables and return error value.
-				free_largenumber(negated);
-				negated = NULL;
-				return NULL;
-			}
-			negated->tail->next = made_segment;
-			made_segment->prev = negated->tail;
-			negated->tail = made_segment;
-		}
-	}
-	
-	else{
-		value_negate -= number->head->value;
-		negated->head->value = 	MAXVALUE - value_negate;
+	if( !init_gcd_state(&top, state->one, state->two, segments, &steps)){
+		free_gcd_matrix(&steps);
+		return -1;
+	}
+	if( (result = half_gcd(&top)) == 1){
+		result = apply_gcd_steps(state, steps.entries, bound);
+	}
+	free_gcd_state(&top);
+	free_gcd_matrix(&steps);
+	return result;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	half_gcd
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reduces a pair of numbers about halfway towards their greatest common
+ |				divisor, gathering the steps in the matrix of the pair.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		state,				The pair being reduced.
+ |	@return:	1,					The pair was reduced.
+ |				0,					The pair could not be reduced.
+ |				-1,					An error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Steps are taken while both numbers keep more than n/2 + 1 segments, for n
+ |				segments in the larger. Above the gcd threshold, the first half of those
+ |				steps are found by recursing on the top half of the numbers, and most of the
+ |				rest by recursing on the top of the numbers that remain.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int half_gcd(gcd_state* state){
+	size_t size = number_size(state->one) > number_size(state->two)
+				  ? number_size(state->one) : number_size(state->two);
+	size_t bound = size / 2 + 1, remaining;
+	int result, reduced = 0;
 
-		if(cond->next == NULL){
-			if(negated->sign == NEGATIVE){
-				negated->sign = POSITIVE;
+	if( size >= gcd_threshold){
+		if( (result = recurse_gcd(state, size / 2, bound)) < 0){
+			return -1;
+		}
+		reduced |= result;
+
+		///Single steps bring the numbers down to three quarters of their size.
+		while( (number_size(state->one) > number_size(state->two)
+				? number_size(state->one) : number_size(state->two)) > 3 * size / 4 + 1){
+			if( (result = reduce_step(state, bound)) < 0){
+				return -1;
 			}
-			else{
-				negated->sign = NEGATIVE;
+			if( result == 0){
+				return reduced;
 			}
+			reduced = 1;
 		}
-		else{
-			for(cond = cond->next; cond != NULL; cond = cond->next){
-				if( (made_segment = init_segment(0)) == NULL){
-					///Allocation failed, free allocated variables and return error value.
-					free_largenumber(negated);
-					negated = NULL;
-					return NULL;
-				}
-				negated->tail->next = made_segment;
-				made_segment->prev = negated->tail;
-				negated->tail = made_segment;
-			
-				if(satisfied){
-					negated->tail->value = cond->value;
-				}
-				else{
-					if( cond->value > 0){
-						negated->tail->value = cond->value - 1;
-						satisfied = 1;
-					}
-					else{
-						negated->tail->value = MAXVALUE - 1;
-					}
-				}
-			}
-		}
-	}
-	
-	return negated;
+
+		remaining = number_size(state->one) > number_size(state->two)
+					? number_size(state->one) : number_size(state->two);
+		if( remaining > bound + 2){
+			if( (result = recurse_gcd(state, 2 * bound - remaining + 1, bound)) < 0){
+				return -1;
+			}
+			reduced |= result;
+		}
+	}
+
+	while( (result = reduce_step(state, bound)) == 1){
+		reduced = 1;
+	}
+	return result < 0 ? -1 : reduced;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	multiply_largenumber
+ |	Function:	euclid_gcd
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Multiplies a single value to a large number.
+ |	Purpose:	Reduces a pair of numbers until one of them is zero, leaving the other as
+ |				their greatest common divisor.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		number,				The number that will be multiplied.
- |				value_multiplying,	The value that will be multiplied to the number.
- |	@return:	product,			The value of the large number multiplied by given value.
- |				NULL,				An error occured whilst allocating
+ |	@param:		state,				The pair being reduced.
+ |	@return:	1,					The pair was reduced.
+ |				0,					An error occured whilst allocating.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* multiply_largenumber(large_number* number, int value_multiplying){
-	large_number* product;					//Return value.
-	segment* cond_i, *cond_j, *made_segment;
-	unsigned long long value_adding;
-	
-	if( (product = init_largenumber(0)) == NULL){
-		return NULL;						//Allocation unsuccessful, return error value.
-	}
-
-	///If the signs are different, then the numbers sign is changed.
-	if(number->sign == POSITIVE && value_multiplying < 0){
-		value_multiplying = -value_multiplying;
-		product->sign = NEGATIVE;
-	}
-	else if(number->sign == NEGATIVE && value_multiplying >= 0){
-		product->sign = POSITIVE;
-	}
-	//Does not need to do computation if value is zero.
-	if(value_multiplying == 0){
-		return product;
-	}
-	
-	///Goes through every segment in the number, multiplies if, and carries the values
-	///through.
-	for( cond_i = number->tail; cond_i != NULL; cond_i = cond_i->prev){
-		value_adding = (unsigned long long) cond_i->value * value_multiplying;
-		
-		cond_j = product->head;
-		while(1){
-			value_adding += cond_j->value;
-			cond_j->value = value_adding % MAXVALUE;
-			
-			//Checks if there is any value that carries over to next segment.
-			if( (value_adding / MAXVALUE) > 0){
-				///Checks if there is a segment the value can be added to.
-				if(cond_j->next == NULL){
-					//Segment needed, one is added to the end of the product.
-					if( (made_segment = init_segment(0)) == NULL){
-						free_largenumber(product);
-						product = NULL;
-						return NULL;
-					}
-					cond_j->next = made_segment;
-					made_segment->prev = cond_j;
-					cond_j = made_segment;
-					product->tail = made_segment;
-				}
+static int euclid_gcd(gcd_state* state){
+	size_t size;
+	int result;
+
+	while( number_size(state->one) > 0 && number_size(state->two) > 0){
+		size = number_size(state->one) > number_size(state->two)
+			   ? number_size(state->one) : number_size(state->two);
+
+		///Large pairs drop a sixth of their size each time the top two thirds are halved.
+		if( size >= gcd_threshold){
+			if( (result = recurse_gcd(state, size / 3, 0)) < 0){
+				return 0;
+			}
+			if( result == 1){
 				continue;
 			}
-			else break;
 		}
-		
-		if(cond_i->prev != NULL){
-			//A segment is required to be added to the head of the product.
-			if( (made_segment = init_segment(0)) == NULL){
-				free_largenumber(product);
-				product = NULL;
-				return NULL;
-			}
-			product->head->prev = made_segment;
-			made_segment->next = product->head;
-			product->head = made_segment;
+		if( reduce_step(state, 0) < 0){
+			return 0;
 		}
 	}
-	
-	return product;
+	return 1;
 }
 
 /*
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Function:	multiply_two_largenumbers
+ |	Function:	gcd_largenumber
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	Purpose:	Multiplies two large numbers together.
+ |	Purpose:	Finds the greatest common divisor of two large numbers.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
- |	@param:		number,				The number that will be multiplied.
- |				value_multiplying,	The value that will be multiplied to the number.
- |	@return:	product,			The value of the two numbers multiplied together.
- |				NULL,				An error occured whilst adding a segment.
+ |	@param:		number_one,			The first number.
+ |				number_two,			The second number.
+ |	@return:	The greatest common divisor, never negative, which is zero only if both
+ |				numbers are. NULL if an error occured whilst allocating.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Small pairs are reduced with lehmer's method, and pairs of gcd_threshold
+ |				segments or more with a recursive half gcd.
  --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
-large_number* multiply_two_largenumbers(large_number* mult_one, large_number* mult_two){
-	large_number* product, *partial_prod, *todelete_number;
-	segment *cond, *made_segment;
-	int offset, counter;					//Used to track the offset for partial products.
-	
-	if( (product = init_largenumber(0)) == NULL){
-		return NULL;
+large_number* gcd_largenumber(large_number* number_one, large_number* number_two){
+	large_number* divisor;
+	gcd_state state;
+	largenumber_arena* previous = use_largenumber_arena(NULL);
+
+	if( !init_gcd_state(&state, number_one, number_two, 0, NULL)){
+		return restore_arena(NULL, previous);
+	}
+	if( !euclid_gcd(&state)){
+		free_gcd_state(&state);
+		return restore_arena(NULL, previous);
 	}
-	
-	if( mult_one->sign == mult_two->sign){
-		product->sign = POSITIVE;
+
+	///The number left nonzero is the divisor, and is taken out of the state to be returned.
+	if( number_size(state.one) > 0){
+		divisor = state.one;
+		state.one = NULL;
 	}
 	else{
-		product->sign = NEGATIVE;
-	}
-	
-	offset = 0;
-	for( cond = mult_one->head; cond != NULL; cond = cond->next){
-		partial_prod = multiply_largenumber(mult_two, cond->value);
-		
-		//Adds padding to the start of the partial product equal to the current offset - 1.
-		for( counter = offset; counter > 0; counter--){
-			///Blank segment is added to the front of the partial product.
-			if( (made_segment = init_segment(0)) == NULL){
-				///Allocation failed, free all allocated memory and return error value.
-				free_largenumber(partial_prod);
-				partial_prod = NULL;
-				free_largenumber(product);
-				product = NULL;
-				return NULL;
-			}
-			partial_prod->head->prev = made_segment;
-			made_segment->next = partial_prod->head;
-			partial_prod->head = made_segment;
-		}
-		///Adds the partial product to the full product.
-		todelete_number = product;			//Required to free after.
-		product = add_two_largenumbers(product, partial_prod);
-		
-		//Frees the allocated numbers that will or have been reassigned values.
-		free_largenumber(todelete_number);
-		todelete_number = NULL;
-		free_largenumber(partial_prod);
-		partial_prod = NULL;
-		
-		offset++;
-	}
-	
-	return product;
+		divisor = state.two;
+		state.two = NULL;
+	}
+	free_gcd_state(&state);
+	trim_largenumber(divisor);
+	return restore_arena(divisor, previous);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	gcdext_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the greatest common divisor of two large numbers, along with the
+ |				coefficients that make it from them.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		divisor,			Where the divisor is written, never negative.
+ |				coefficient_one,	Where x is written so x * number_one + y * number_two
+ |									is the divisor, or NULL if it is not needed.
+ |				coefficient_two,	Where y is written, or NULL if it is not needed.
+ |				number_one,			The first number.
+ |				number_two,			The second number.
+ |	@return:	1,					The divisor was found.
+ |				0,					An error occured whilst allocating, the outputs may have
+ |									been changed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Any output may be the same as either number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int gcdext_largenumber(large_number* divisor, large_number* coefficient_one,
+						large_number* coefficient_two, large_number* number_one,
+						large_number* number_two){
+	char sign_one = number_one->sign, sign_two = number_two->sign;
+	large_number* coefficients[2];
+	gcd_matrix matrix;
+	gcd_state state;
+	int i, success;
+	largenumber_arena* previous = use_largenumber_arena(NULL);
+
+	if( !init_gcd_matrix(&matrix)){
+		use_largenumber_arena(previous);
+		return 0;
+	}
+	if( !init_gcd_state(&state, number_one, number_two, 0, &matrix)){
+		free_gcd_matrix(&matrix);
+		use_largenumber_arena(previous);
+		return 0;
+	}
+	success = euclid_gcd(&state);
+
+	///With the pair ending as (g, 0) the original pair is g times the first column of the
+	///matrix, and as (0, g) the second, so the inverse matrix's row that makes g gives
+	///the coefficients.
+	if( number_size(state.two) == 0){
+		coefficients[0] = matrix.entries[1][1];
+		coefficients[1] = matrix.entries[0][1];
+		coefficients[1]->sign = NEGATIVE;
+	}
+	else{
+		coefficients[0] = matrix.entries[1][0];
+		coefficients[1] = matrix.entries[0][0];
+		coefficients[0]->sign = NEGATIVE;
+	}
+	for( i = 0; i < 2; i++){
+		if( (i == 0 ? sign_one : sign_two) == NEGATIVE){
+			coefficients[i]->sign ^= NEGATIVE;
+		}
+		trim_largenumber(coefficients[i]);
+	}
+
+	if( success){
+		success = assign_largenumber(divisor, number_size(state.one) > 0 ? state.one : state.two)
+				  && (coefficient_one == NULL
+					  || assign_largenumber(coefficient_one, coefficients[0]))
+				  && (coefficient_two == NULL
+					  || assign_largenumber(coefficient_two, coefficients[1]));
+		trim_largenumber(divisor);
+	}
+	free_gcd_state(&state);
+	free_gcd_matrix(&matrix);
+	use_largenumber_arena(previous);
+	return success;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	modinv_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the inverse of a large number modulo another.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		inverse,			Where the inverse is written, from zero up to but not
+ |									including the size of the modulus. It may be the same
+ |									as either number.
+ |				number,				The number being inverted.
+ |				modulus,			The modulus, whose sign is ignored.
+ |	@return:	1,					The inverse was found.
+ |				0,					An error occured whilst allocating.
+ |				-1,					The modulus is zero, or shares a factor with the number
+ |									so there is no inverse. The inverse is unchanged.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+int modinv_largenumber(large_number* inverse, large_number* number, large_number* modulus){
+	large_number* divisor, *coefficient, *positive_modulus;
+	large_number divisor_one;
+	segment one_segments[3];
+	int result = 0;
+	largenumber_arena* previous;
+
+	if( number_size(modulus) == 0){
+		return -1;
+	}
+	///Only the inverse given is written, the rest are held in numbers from the pool.
+	previous = use_largenumber_arena(NULL);
+	divisor = init_largenumber(0);
+	coefficient = init_largenumber(0);
+	positive_modulus = divisor == NULL || coefficient == NULL ? NULL : copy_largenumber(modulus);
+	if( positive_modulus != NULL){
+		positive_modulus->sign = POSITIVE;
+		result = gcdext_largenumber(divisor, coefficient, NULL, number, positive_modulus);
+	}
+	value_largenumber(&divisor_one, one_segments, 1);
+	if( result && compare_segments(divisor->segments, divisor->size,
+								   divisor_one.segments, divisor_one.size) != 0){
+		result = -1;
+	}
+
+	///The coefficient is brought into range, taking the negative case up to the modulus.
+	if( result == 1){
+		if( divmod_largenumber(NULL, coefficient, coefficient, positive_modulus) != 1
+		   || (coefficient->sign == NEGATIVE
+			   && !add_into_largenumber(coefficient, coefficient, positive_modulus))
+		   || !assign_largenumber(inverse, coefficient)){
+			result = 0;
+		}
+	}
+	free_largenumber(positive_modulus);
+	free_largenumber(coefficient);
+	free_largenumber(divisor);
+	use_largenumber_arena(previous);
+	return result;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_gcd_threshold
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments a pair of numbers needs before their greatest
+ |				common divisor is found with the recursive half gcd instead of lehmer's
+ |				method alone.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		threshold			The amount of segments, at least eight.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+void set_gcd_threshold(size_t threshold){
+	gcd_threshold = threshold < 8 ? 8 : threshold;
 }
 
 int main(){
 	large_number* one;
 	char* buffer = malloc(128*sizeof(char));
-	
-	while(1){
-		memset(buffer, '\0', strlen(buffer));
-		scanf("%s", buffer);
-		one = stolargenumber(buffer);
+
+	while( scanf("%127s", buffer) == 1){
+		if( (one = stolargenumber(buffer)) == NULL){
+			printf("%s is not a number\n", buffer);
+			continue;
+		}
 		print_largenumber(one);
+		free_largenumber(one);
 	}
-	
-	
-	
-	
-	
+	free(buffer);
+
 	return 0;
 }
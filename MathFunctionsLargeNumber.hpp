@@ -0,0 +1,987 @@
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Filename:	MathFunctionsLargeNumber.hpp
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Declares LargeNumber, a C++ class that owns a large number and frees it
+ |				when it goes out of scope, with operators built on the C functions, and
+ |				BigInt, a number of a fixed amount of segments held without the heap.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Dependancy:	MathFunctionsLargeNumber.h,	climits,	cstring,	functional,	new,
+ |				ostream,	stdexcept,	string,	type_traits,	utility
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+#ifndef MATHFUNCTIONSLARGENUMBER_HPP
+#define MATHFUNCTIONSLARGENUMBER_HPP
+
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "MathFunctionsLargeNumber.h"
+
+/*
+ *	Constant expressions can only hold loops from C++14, before which the BigInt kernels
+ *	are ordinary inline functions.
+ */
+#if __cplusplus >= 201402L
+#define LARGENUMBER_CONSTEXPR	constexpr
+#else
+#define LARGENUMBER_CONSTEXPR	inline
+#endif
+
+class LargeNumber;
+
+/*
+ *	Every lazy expression derives from LargeNumberExpression, which is how operators and
+ *	conversions tell them apart from other types.
+ */
+class LargeNumberExpression{};
+
+namespace largenumber_detail{
+	template<typename Type> struct is_expression
+		: std::is_base_of<LargeNumberExpression, typename std::decay<Type>::type>{};
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Class:		LargeNumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Owns a large number, freeing it when destroyed, so temporaries in a chain
+ |				of operations are never leaked.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		held,				The number owned, or NULL once it has been moved from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Allocation failures throw std::bad_alloc, and dividing by zero or taking the
+ |				square root of a negative number throws std::domain_error. Characters that
+ |				are not a number throw std::invalid_argument. Moving takes the storage of
+ |				the number moved from, which may then only be assigned to or destroyed.
+ |				Addition, negation and multiplication build lazy expressions, which are
+ |				only evaluated once they are stored in a LargeNumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+class LargeNumber{
+public:
+	LargeNumber() : held(checked(init_largenumber(0))){}
+	///Any integer converts, a literal 0 would otherwise also match the character pointer.
+	template<typename Integer,
+			 typename = typename std::enable_if<std::is_integral<Integer>::value>::type>
+	LargeNumber(Integer value) : held(checked(init_largenumber((long long) value))){
+		if( value > 0 && (unsigned long long) value > LLONG_MAX){
+			from_unsigned((unsigned long long) value);
+		}
+	}
+	explicit LargeNumber(const char* characters) : held(parsed(characters)){}
+	explicit LargeNumber(const std::string& characters) : LargeNumber(characters.c_str()){}
+	template<typename Expression, typename = typename std::enable_if<
+		largenumber_detail::is_expression<Expression>::value>::type>
+	LargeNumber(const Expression& expression) : LargeNumber(){
+		expression.evaluate_into(held);
+	}
+	LargeNumber(const LargeNumber& other) : held(checked(copy_largenumber(other.held))){}
+	LargeNumber(LargeNumber&& other) noexcept : held(other.held){
+		other.held = NULL;
+	}
+	~LargeNumber(){
+		free_largenumber(held);
+	}
+
+	LargeNumber& operator=(const LargeNumber& other);
+	LargeNumber& operator=(LargeNumber&& other) noexcept{
+		std::swap(held, other.held);
+		return *this;
+	}
+	template<typename Expression>
+	typename std::enable_if<largenumber_detail::is_expression<Expression>::value,
+							LargeNumber&>::type operator=(const Expression& expression){
+		///An expression reading this number is built elsewhere, as it would be overwritten
+		///before being read, as is one stored in a number that was moved from.
+		if( held == NULL || expression.refers_to(held)){
+			return *this = LargeNumber(expression);
+		}
+		expression.evaluate_into(held);
+		return *this;
+	}
+
+	static LargeNumber adopt(large_number* number);
+	large_number* get() const noexcept{
+		return held;
+	}
+	large_number* release() noexcept{
+		large_number* releasing = held;
+
+		held = NULL;
+		return releasing;
+	}
+
+	LargeNumber& operator+=(const LargeNumber& other){
+		add_into(held, held, other.held);
+		return *this;
+	}
+	LargeNumber& operator-=(const LargeNumber& other){
+		sub_into(held, held, other.held);
+		return *this;
+	}
+	template<typename Expression>
+	typename std::enable_if<largenumber_detail::is_expression<Expression>::value,
+							LargeNumber&>::type operator+=(const Expression& expression){
+		if( expression.refers_to(held)){
+			return *this += LargeNumber(expression);
+		}
+		expression.accumulate_into(held, false);
+		return *this;
+	}
+	template<typename Expression>
+	typename std::enable_if<largenumber_detail::is_expression<Expression>::value,
+							LargeNumber&>::type operator-=(const Expression& expression){
+		if( expression.refers_to(held)){
+			return *this -= LargeNumber(expression);
+		}
+		expression.accumulate_into(held, true);
+		return *this;
+	}
+	LargeNumber& operator*=(const LargeNumber& other){
+		multiply_into(held, held, other.held);
+		return *this;
+	}
+	LargeNumber& operator/=(const LargeNumber& other){
+		div_into(held, held, other.held);
+		return *this;
+	}
+	LargeNumber& operator%=(const LargeNumber& other){
+		mod_into(held, held, other.held);
+		return *this;
+	}
+
+	LargeNumber operator-() const&{
+		return -LargeNumber(*this);
+	}
+	LargeNumber operator-() &&{
+		if( !is_zero()){
+			held->sign = held->sign == POSITIVE ? NEGATIVE : POSITIVE;
+		}
+		return std::move(*this);
+	}
+
+	bool is_zero() const noexcept{
+		return held->size == 1 && held->segments[0] == 0;
+	}
+	bool is_negative() const noexcept{
+		return held->sign == NEGATIVE;
+	}
+	explicit operator bool() const noexcept{
+		return !is_zero();
+	}
+
+	std::string to_string() const;
+	std::size_t hash() const noexcept;
+
+	///The into functions store the result of an operation in a number whose storage is
+	///reused, which may be either operand, throwing instead of returning failure.
+	static void add_into(large_number* result, large_number* one, large_number* two){
+		checked(add_into_largenumber(result, one, two));
+	}
+	static void sub_into(large_number* result, large_number* one, large_number* two){
+		checked(sub_into_largenumber(result, one, two));
+	}
+	static void multiply_into(large_number* result, large_number* one, large_number* two){
+		checked(multiply_into_largenumber(result, one, two));
+	}
+	static void addmul_into(large_number* result, large_number* one, large_number* two){
+		checked(addmul_into_largenumber(result, one, two));
+	}
+	static void submul_into(large_number* result, large_number* one, large_number* two){
+		checked(submul_into_largenumber(result, one, two));
+	}
+	static void assign_into(large_number* result, const large_number* value);
+	static void div_into(large_number* result, large_number* one, large_number* two){
+		checked(divmod_largenumber(result, NULL, one, two));
+	}
+	static void mod_into(large_number* result, large_number* one, large_number* two){
+		checked(divmod_largenumber(NULL, result, one, two));
+	}
+
+private:
+	struct adopting{};
+	void from_unsigned(unsigned long long value){
+		LargeNumber odd((long long) (value & 1));
+
+		checked(resize_largenumber(held, 1));
+		held->segments[0] = 0;
+		held->sign = POSITIVE;
+		//Halved so it fits a long long, then doubled back.
+		*this += LargeNumber((long long) (value >> 1));
+		*this += *this;
+		*this += odd;
+	}
+	LargeNumber(large_number* number, adopting) noexcept : held(number){}
+
+	static large_number* checked(large_number* number){
+		if( number == NULL){
+			throw std::bad_alloc();
+		}
+		return number;
+	}
+	static large_number* parsed(const char* characters){
+		//The characters are only read, the C function is not declared const.
+		large_number* number = stolargenumber(const_cast<char*>(characters));
+
+		if( number == NULL){
+			throw std::invalid_argument("characters are not a large number");
+		}
+		return number;
+	}
+	static void checked(int result){
+		if( result == 0){
+			throw std::bad_alloc();
+		}
+		if( result < 0){
+			throw std::domain_error("large number divided by zero");
+		}
+	}
+
+	large_number* held;
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	LargeNumber::operator=
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Copies the value of another number, reusing the storage already held.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		other,				The number being copied.
+ |	@return:	This number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+inline LargeNumber& LargeNumber::operator=(const LargeNumber& other){
+	if( held == NULL){
+		held = checked(copy_largenumber(other.held));
+	}
+	else{
+		assign_into(held, other.held);
+	}
+	return *this;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	LargeNumber::assign_into
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Copies the value of a large number into another, reusing its storage.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		result,				The number being set, may be the value.
+ |				value,				The number whose value it takes.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+inline void LargeNumber::assign_into(large_number* result, const large_number* value){
+	if( result == value){
+		return;
+	}
+	checked(resize_largenumber(result, value->size));
+	std::memcpy(result->segments, value->segments, value->size * sizeof(segment));
+	result->sign = value->sign;
+	result->decimal_position = value->decimal_position;
+	result->max_dec_places = value->max_dec_places;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	LargeNumber::adopt
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Takes ownership of a number returned by a C function.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number, which is freed with the LargeNumber. NULL,
+ |									as returned on an allocation failure, throws.
+ |	@return:	The LargeNumber owning it.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+inline LargeNumber LargeNumber::adopt(large_number* number){
+	return LargeNumber(checked(number), adopting());
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	LargeNumber::to_string
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Writes the base ten characters of the number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The characters.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+inline std::string LargeNumber::to_string() const{
+	std::size_t length;
+	char* characters = largenumber_to_new_string(held, &length);
+
+	if( characters == NULL){
+		throw std::bad_alloc();
+	}
+	//The number is converted once, into a buffer that is freed even if copying it throws.
+	try{
+		std::string converted(characters, length);
+		free(characters);
+		return converted;
+	}
+	catch( ...){
+		free(characters);
+		throw;
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	LargeNumber::hash
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Hashes the value of the number, with FNV-1a over its sign and segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The hash, the same for any two equal numbers.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+inline std::size_t LargeNumber::hash() const noexcept{
+	unsigned long long hashed = 14695981039346656037ULL ^ (unsigned char) held->sign;
+	std::size_t i;
+
+	for( i = 0; i < held->size; i++){
+		hashed = (hashed ^ held->segments[i]) * 1099511628211ULL;
+	}
+	return (std::size_t) hashed;
+}
+
+/*
+ *	Division has four forms, so that whichever operands are temporaries give up their
+ *	storage for the result, and only two named operands allocate.
+ */
+#define LARGENUMBER_OPERATOR(symbol, into)												\
+	inline LargeNumber operator symbol(const LargeNumber& one, const LargeNumber& two){	\
+		LargeNumber result;																\
+		LargeNumber::into(result.get(), one.get(), two.get());							\
+		return result;																	\
+	}																					\
+	inline LargeNumber operator symbol(LargeNumber&& one, const LargeNumber& two){		\
+		LargeNumber::into(one.get(), one.get(), two.get());								\
+		return std::move(one);															\
+	}																					\
+	inline LargeNumber operator symbol(const LargeNumber& one, LargeNumber&& two){		\
+		LargeNumber::into(two.get(), one.get(), two.get());								\
+		return std::move(two);															\
+	}																					\
+	inline LargeNumber operator symbol(LargeNumber&& one, LargeNumber&& two){			\
+		LargeNumber::into(one.get(), one.get(), two.get());								\
+		return std::move(one);															\
+	}
+
+LARGENUMBER_OPERATOR(/, div_into)
+LARGENUMBER_OPERATOR(%, mod_into)
+
+#undef LARGENUMBER_OPERATOR
+
+/*
+ *	The operands of an expression are held as a reference to a named LargeNumber, or by
+ *	value for a temporary, an integer or another expression, so an expression never
+ *	refers to anything destroyed before it is evaluated.
+ */
+namespace largenumber_detail{
+	template<typename Type, typename Decayed = typename std::decay<Type>::type,
+			 typename = void> struct operand{};
+	template<typename Type> struct operand<Type, LargeNumber>{
+		typedef typename std::conditional<std::is_lvalue_reference<Type>::value,
+										  const LargeNumber&, LargeNumber>::type type;
+	};
+	template<typename Type, typename Decayed> struct operand<Type, Decayed,
+		typename std::enable_if<std::is_integral<Decayed>::value>::type>{
+		typedef LargeNumber type;
+	};
+	template<typename Type, typename Decayed> struct operand<Type, Decayed,
+		typename std::enable_if<is_expression<Decayed>::value>::type>{
+		typedef Decayed type;
+	};
+
+	///Operators are only lazy when at least one side is a LargeNumber or an expression.
+	template<typename One, typename Two> struct is_lazy : std::integral_constant<bool,
+		std::is_same<typename std::decay<One>::type, LargeNumber>::value
+		|| std::is_same<typename std::decay<Two>::type, LargeNumber>::value
+		|| is_expression<One>::value || is_expression<Two>::value>{};
+
+	inline bool refers_to(const LargeNumber& number, const large_number* result){
+		return number.get() == result;
+	}
+	template<typename Expression>
+	bool refers_to(const Expression& expression, const large_number* result){
+		return expression.refers_to(result);
+	}
+
+	inline void evaluate(large_number* result, const LargeNumber& number){
+		LargeNumber::assign_into(result, number.get());
+	}
+	template<typename Expression>
+	void evaluate(large_number* result, const Expression& expression){
+		expression.evaluate_into(result);
+	}
+
+	inline void accumulate(large_number* result, const LargeNumber& number, bool negate){
+		if( negate){
+			LargeNumber::sub_into(result, result, number.get());
+		}
+		else{
+			LargeNumber::add_into(result, result, number.get());
+		}
+	}
+	template<typename Expression>
+	void accumulate(large_number* result, const Expression& expression, bool negate){
+		expression.accumulate_into(result, negate);
+	}
+
+	inline void evaluate_sum(large_number* result, const LargeNumber& one,
+							 const LargeNumber& two, bool subtract){
+		if( subtract){
+			LargeNumber::sub_into(result, one.get(), two.get());
+		}
+		else{
+			LargeNumber::add_into(result, one.get(), two.get());
+		}
+	}
+	template<typename One, typename Two>
+	void evaluate_sum(large_number* result, const One& one, const Two& two, bool subtract){
+		evaluate(result, one);
+		accumulate(result, two, subtract);
+	}
+
+	/*
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Class:		factor
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Purpose:	Gives the number a multiplication reads, the LargeNumber itself or an
+	 |				expression evaluated into a number of its own.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 */
+	class factor{
+	public:
+		factor(const LargeNumber& number) noexcept : holding(NULL), value(number.get()){}
+		template<typename Expression>
+		factor(const Expression& expression) : holding(NULL), value(NULL){
+			value = holding = LargeNumber(expression).release();
+		}
+		~factor(){
+			free_largenumber(holding);
+		}
+		large_number* get() const noexcept{
+			return value;
+		}
+
+	private:
+		factor(const factor&);
+		factor& operator=(const factor&);
+
+		large_number* holding;
+		large_number* value;
+	};
+
+	///A product with an expression for an operand evaluates it straight into the result,
+	///which is then multiplied in place. The tags say which operands are expressions.
+	template<typename One, typename Two, typename Tag>
+	void evaluate_product(large_number* result, const One& one, const Two& two,
+						  std::true_type, Tag){
+		factor second(two);
+
+		one.evaluate_into(result);
+		LargeNumber::multiply_into(result, result, second.get());
+	}
+	template<typename One, typename Two>
+	void evaluate_product(large_number* result, const One& one, const Two& two,
+						  std::false_type, std::true_type){
+		evaluate_product(result, two, one, std::true_type(), std::false_type());
+	}
+	template<typename One, typename Two>
+	void evaluate_product(large_number* result, const One& one, const Two& two,
+						  std::false_type, std::false_type){
+		LargeNumber::multiply_into(result, one.get(), two.get());
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Class:		LargeNumberSum
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The lazy sum, or difference when Subtract is set, of two operands.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		one, two,			The operands, as held by largenumber_detail::operand.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Evaluating sets the result to the first operand and then adds every further
+ |				term onto it, so a product anywhere but first is added with
+ |				addmul_into_largenumber rather than built on its own.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<typename One, typename Two, bool Subtract>
+class LargeNumberSum : public LargeNumberExpression{
+public:
+	template<typename First, typename Second>
+	LargeNumberSum(First&& first, Second&& second)
+		: one(std::forward<First>(first)), two(std::forward<Second>(second)){}
+
+	bool refers_to(const large_number* result) const{
+		return largenumber_detail::refers_to(one, result)
+			   || largenumber_detail::refers_to(two, result);
+	}
+	///The result must not be read by the expression.
+	void evaluate_into(large_number* result) const{
+		largenumber_detail::evaluate_sum(result, one, two, Subtract);
+	}
+	void accumulate_into(large_number* result, bool negate) const{
+		largenumber_detail::accumulate(result, one, negate);
+		largenumber_detail::accumulate(result, two, negate != Subtract);
+	}
+
+private:
+	One one;
+	Two two;
+};
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Class:		LargeNumberProduct
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	The lazy product of two operands.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		one, two,			The operands, as held by largenumber_detail::operand.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<typename One, typename Two>
+class LargeNumberProduct : public LargeNumberExpression{
+public:
+	template<typename First, typename Second>
+	LargeNumberProduct(First&& first, Second&& second)
+		: one(std::forward<First>(first)), two(std::forward<Second>(second)){}
+
+	bool refers_to(const large_number* result) const{
+		return largenumber_detail::refers_to(one, result)
+			   || largenumber_detail::refers_to(two, result);
+	}
+	void evaluate_into(large_number* result) const{
+		largenumber_detail::evaluate_product(result, one, two,
+											 largenumber_detail::is_expression<One>(),
+											 largenumber_detail::is_expression<Two>());
+	}
+	void accumulate_into(large_number* result, bool negate) const{
+		largenumber_detail::factor first(one), second(two);
+
+		if( negate){
+			LargeNumber::submul_into(result, first.get(), second.get());
+		}
+		else{
+			LargeNumber::addmul_into(result, first.get(), second.get());
+		}
+	}
+
+private:
+	One one;
+	Two two;
+};
+
+template<typename One, typename Two,
+		 typename = typename std::enable_if<largenumber_detail::is_lazy<One, Two>::value>::type>
+LargeNumberSum<typename largenumber_detail::operand<One>::type,
+			   typename largenumber_detail::operand<Two>::type, false>
+operator+(One&& one, Two&& two){
+	return LargeNumberSum<typename largenumber_detail::operand<One>::type,
+						  typename largenumber_detail::operand<Two>::type, false>(
+		std::forward<One>(one), std::forward<Two>(two));
+}
+
+template<typename One, typename Two,
+		 typename = typename std::enable_if<largenumber_detail::is_lazy<One, Two>::value>::type>
+LargeNumberSum<typename largenumber_detail::operand<One>::type,
+			   typename largenumber_detail::operand<Two>::type, true>
+operator-(One&& one, Two&& two){
+	return LargeNumberSum<typename largenumber_detail::operand<One>::type,
+						  typename largenumber_detail::operand<Two>::type, true>(
+		std::forward<One>(one), std::forward<Two>(two));
+}
+
+template<typename One, typename Two,
+		 typename = typename std::enable_if<largenumber_detail::is_lazy<One, Two>::value>::type>
+LargeNumberProduct<typename largenumber_detail::operand<One>::type,
+				   typename largenumber_detail::operand<Two>::type>
+operator*(One&& one, Two&& two){
+	return LargeNumberProduct<typename largenumber_detail::operand<One>::type,
+							  typename largenumber_detail::operand<Two>::type>(
+		std::forward<One>(one), std::forward<Two>(two));
+}
+
+template<typename Expression>
+typename std::enable_if<largenumber_detail::is_expression<Expression>::value,
+						LargeNumber>::type operator-(const Expression& expression){
+	return -LargeNumber(expression);
+}
+
+inline bool operator==(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) == 0;
+}
+inline bool operator!=(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) != 0;
+}
+inline bool operator<(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) < 0;
+}
+inline bool operator>(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) > 0;
+}
+inline bool operator<=(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) <= 0;
+}
+inline bool operator>=(const LargeNumber& one, const LargeNumber& two){
+	return compare_largenumber(one.get(), two.get()) >= 0;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const LargeNumber& number){
+	return stream << number.to_string();
+}
+
+inline LargeNumber pow(const LargeNumber& base, unsigned int exponent){
+	return LargeNumber::adopt(pow_largenumber(base.get(), exponent));
+}
+
+inline LargeNumber sqrt(const LargeNumber& number){
+	if( number.is_negative()){
+		throw std::domain_error("square root of a negative large number");
+	}
+	return LargeNumber::adopt(sqrt_largenumber(number.get(), NULL));
+}
+
+inline LargeNumber gcd(const LargeNumber& one, const LargeNumber& two){
+	return LargeNumber::adopt(gcd_largenumber(one.get(), two.get()));
+}
+
+namespace std{
+	template<> struct hash<LargeNumber>{
+		std::size_t operator()(const LargeNumber& number) const noexcept{
+			return number.hash();
+		}
+	};
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Class:		BigInt
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	A number of at most Segments segments, held inside the object so it never
+ |				touches the heap, whose arithmetic loops have a length known when compiling.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Fields:		segments,			The segments in the same base as a large number, least
+ |									significant first, unused ones set to zero.
+ |				sign,				POSITIVE or NEGATIVE, zero is always POSITIVE.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Note:		Addition, negation, multiplication and comparison are constant expressions
+ |				from C++14. A result that does not fit throws std::overflow_error. Numbers
+ |				convert to and from LargeNumber and large_number by copying segments.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<std::size_t Segments>
+class BigInt{
+	static_assert(Segments > 0, "a BigInt holds at least one segment");
+
+public:
+	constexpr BigInt() : segments{}, sign(POSITIVE){}
+	template<typename Integer,
+			 typename = typename std::enable_if<std::is_integral<Integer>::value>::type>
+	LARGENUMBER_CONSTEXPR BigInt(Integer value) : segments{}, sign(POSITIVE){
+		unsigned long long magnitude = (unsigned long long) value;
+		std::size_t i = 0;
+
+		if( value < Integer()){
+			magnitude = 0ULL - magnitude;
+			sign = NEGATIVE;
+		}
+		for( i = 0; magnitude > 0; i++){
+			if( i == Segments){
+				overflowed();
+			}
+			segments[i] = (segment) (magnitude % MAXVALUE);
+			magnitude /= MAXVALUE;
+		}
+	}
+	explicit BigInt(const large_number* number);
+	explicit BigInt(const LargeNumber& number) : BigInt(number.get()){}
+
+	LargeNumber to_largenumber() const;
+	explicit operator LargeNumber() const{
+		return to_largenumber();
+	}
+	std::string to_string() const{
+		return to_largenumber().to_string();
+	}
+
+	constexpr segment operator[](std::size_t position) const{
+		return segments[position];
+	}
+	LARGENUMBER_CONSTEXPR bool is_zero() const{
+		std::size_t i = 0;
+
+		for( i = 0; i < Segments; i++){
+			if( segments[i] != 0){
+				return false;
+			}
+		}
+		return true;
+	}
+	constexpr bool is_negative() const{
+		return sign == NEGATIVE;
+	}
+
+	LARGENUMBER_CONSTEXPR BigInt operator-() const{
+		BigInt negated = *this;
+
+		if( !is_zero()){
+			negated.sign = sign == POSITIVE ? NEGATIVE : POSITIVE;
+		}
+		return negated;
+	}
+	LARGENUMBER_CONSTEXPR BigInt& operator+=(const BigInt& other){
+		return *this = add_signed(*this, other, other.sign);
+	}
+	LARGENUMBER_CONSTEXPR BigInt& operator-=(const BigInt& other){
+		return *this = add_signed(*this, other, other.sign == POSITIVE ? NEGATIVE : POSITIVE);
+	}
+	LARGENUMBER_CONSTEXPR BigInt& operator*=(const BigInt& other){
+		return *this = multiply(*this, other);
+	}
+
+	///Defined inside the class so integers convert to either operand.
+	friend LARGENUMBER_CONSTEXPR BigInt operator+(const BigInt& one, const BigInt& two){
+		return add_signed(one, two, two.sign);
+	}
+	friend LARGENUMBER_CONSTEXPR BigInt operator-(const BigInt& one, const BigInt& two){
+		return add_signed(one, two, two.sign == POSITIVE ? NEGATIVE : POSITIVE);
+	}
+	friend LARGENUMBER_CONSTEXPR BigInt operator*(const BigInt& one, const BigInt& two){
+		return multiply(one, two);
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator==(const BigInt& one, const BigInt& two){
+		return compare(one, two) == 0;
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator!=(const BigInt& one, const BigInt& two){
+		return compare(one, two) != 0;
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator<(const BigInt& one, const BigInt& two){
+		return compare(one, two) < 0;
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator>(const BigInt& one, const BigInt& two){
+		return compare(one, two) > 0;
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator<=(const BigInt& one, const BigInt& two){
+		return compare(one, two) <= 0;
+	}
+	friend LARGENUMBER_CONSTEXPR bool operator>=(const BigInt& one, const BigInt& two){
+		return compare(one, two) >= 0;
+	}
+	friend std::ostream& operator<<(std::ostream& stream, const BigInt& number){
+		return stream << number.to_string();
+	}
+
+private:
+	static void overflowed(){
+		throw std::overflow_error("BigInt result does not fit its segments");
+	}
+
+	/*
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Function:	compare_magnitudes
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Purpose:	Compares the magnitudes of two numbers, ignoring their signs.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	@return:	1, 0 or -1 as the first is larger, the same or smaller.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 */
+	static LARGENUMBER_CONSTEXPR int compare_magnitudes(const BigInt& one, const BigInt& two){
+		std::size_t i = 0;
+
+		for( i = Segments; i-- > 0;){
+			if( one.segments[i] != two.segments[i]){
+				return one.segments[i] > two.segments[i] ? 1 : -1;
+			}
+		}
+		return 0;
+	}
+
+	static LARGENUMBER_CONSTEXPR int compare(const BigInt& one, const BigInt& two){
+		if( one.sign != two.sign){
+			return one.sign == POSITIVE ? 1 : -1;
+		}
+		return one.sign == POSITIVE ? compare_magnitudes(one, two)
+									: compare_magnitudes(two, one);
+	}
+
+	/*
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Function:	add_signed
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Purpose:	Adds two numbers, with the sign of the second one given separately so
+	 |				subtraction can share the operation.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	@param:		one,				The first part of the addition.
+	 |				two,				The second part of the addition.
+	 |				sign_two,			The sign the second number is treated as having.
+	 |	@return:	The sum.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 */
+	static LARGENUMBER_CONSTEXPR BigInt add_signed(const BigInt& one, const BigInt& two,
+												   char sign_two){
+		BigInt sum;
+		const BigInt* larger = &one, *smaller = &two;
+		unsigned long long value_adding = 0;
+		segment carry = 0;
+		std::size_t i = 0;
+
+		///When the signs are the same the magnitudes are added, otherwise the smaller
+		///magnitude is negated from the larger and the larger decides the sign.
+		if( one.sign == sign_two){
+			for( i = 0; i < Segments; i++){
+				value_adding = (unsigned long long) one.segments[i] + two.segments[i] + carry;
+				carry = value_adding >= MAXVALUE;
+				sum.segments[i] = (segment) (carry ? value_adding - MAXVALUE : value_adding);
+			}
+			if( carry != 0){
+				overflowed();
+			}
+			sum.sign = one.sign;
+		}
+		else{
+			if( compare_magnitudes(one, two) < 0){
+				larger = &two;
+				smaller = &one;
+			}
+			for( i = 0; i < Segments; i++){
+				value_adding = (unsigned long long) smaller->segments[i] + carry;
+				carry = larger->segments[i] < value_adding;
+				sum.segments[i] = (segment) (larger->segments[i] + (carry ? MAXVALUE : 0)
+											 - value_adding);
+			}
+			sum.sign = larger == &one ? one.sign : sign_two;
+		}
+		if( sum.sign == NEGATIVE && sum.is_zero()){
+			sum.sign = POSITIVE;
+		}
+		return sum;
+	}
+
+	/*
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Function:	multiply
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	Purpose:	Multiplies two numbers with the schoolbook method, only walking the
+	 |				segments in use.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 |	@param:		one, two,			The numbers being multiplied.
+	 |	@return:	The product.
+	 --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+	 */
+	static LARGENUMBER_CONSTEXPR BigInt multiply(const BigInt& one, const BigInt& two){
+		BigInt product;
+		unsigned long long value_adding = 0;
+		std::size_t i = 0, j = 0, used = Segments;
+
+		while( used > 0 && two.segments[used - 1] == 0){
+			used--;
+		}
+		///Every segment of the first number adds a partial product, offset by its position,
+		///with the carry landing in a segment no earlier partial product has reached.
+		for( i = 0; i < Segments; i++){
+			if( one.segments[i] == 0){
+				continue;
+			}
+			if( i + used > Segments){
+				overflowed();
+			}
+			value_adding = 0;
+			for( j = 0; j < used; j++){
+				value_adding += (unsigned long long) one.segments[i] * two.segments[j]
+								+ product.segments[i + j];
+				product.segments[i + j] = (segment) (value_adding % MAXVALUE);
+				value_adding /= MAXVALUE;
+			}
+			if( value_adding != 0){
+				if( i + used == Segments){
+					overflowed();
+				}
+				product.segments[i + used] = (segment) value_adding;
+			}
+		}
+		product.sign = one.sign == two.sign || product.is_zero() ? POSITIVE : NEGATIVE;
+		return product;
+	}
+
+	segment segments[Segments];
+	char sign;
+};
+
+/*
+ *	The amount of segments needed to hold every value of a given amount of bits, so a
+ *	BigInt can be declared by its width, such as BigIntBits<256>.
+ */
+constexpr std::size_t largenumber_segments(std::size_t bits){
+#if defined(LARGENUMBER_BINARY)
+	return (bits + 31) / 32;
+#else
+	//2^bits has bits * log10(2) digits, log10(2) being just under 0.30103.
+	return ((bits * 30103 + 99999) / 100000 + SEGMENT_DIGITS - 1) / SEGMENT_DIGITS;
+#endif
+}
+
+template<std::size_t Bits>
+using BigIntBits = BigInt<largenumber_segments(Bits)>;
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	BigInt::BigInt
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Copies the value of a large number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		number,				The number copied, which throws std::overflow_error if
+ |									it has more segments than fit.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<std::size_t Segments>
+BigInt<Segments>::BigInt(const large_number* number) : segments{}, sign(number->sign){
+	std::size_t size = number->size;
+
+	while( size > 1 && number->segments[size - 1] == 0){
+		size--;
+	}
+	if( size > Segments){
+		overflowed();
+	}
+	std::memcpy(segments, number->segments, size * sizeof(segment));
+	if( is_zero()){
+		sign = POSITIVE;
+	}
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	BigInt::to_largenumber
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Copies the value into a LargeNumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The LargeNumber.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<std::size_t Segments>
+LargeNumber BigInt<Segments>::to_largenumber() const{
+	LargeNumber number;
+	std::size_t size = Segments;
+
+	while( size > 1 && segments[size - 1] == 0){
+		size--;
+	}
+	if( !resize_largenumber(number.get(), size)){
+		throw std::bad_alloc();
+	}
+	std::memcpy(number.get()->segments, segments, size * sizeof(segment));
+	number.get()->sign = sign;
+	return number;
+}
+
+#endif
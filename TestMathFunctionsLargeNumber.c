@@ -0,0 +1,837 @@
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Filename:	TestMathFunctionsLargeNumber.c
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Checks that the large number functions give the same results when their
+ |				outputs are the same numbers as their operands, that every multiplication
+ |				method agrees with the schoolbook method, that quotients and remainders
+ |				give back the dividend, that modular powers and barrett reductions agree
+ |				with division, that divisors, inverses and roots meet their identities,
+ |				that saved numbers come back the same, and that characters which are not
+ |				a number and damaged saved numbers are rejected.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Dependancy:	MathFunctionsLargeNumber.h
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+#include "MathFunctionsLargeNumber.h"
+
+static const char* dividends[] = {
+	"0", "7", "-7", "999999999", "1000000000", "-123456789012345678901234567890",
+	"340282366920938463463374607431768211456",
+	"98765432109876543210987654321098765432109876543210987654321098765432109876543210"
+};
+static const char* divisors[] = {
+	"1", "-3", "1000000000", "4294967296", "-98765432109876543210",
+	"123456789012345678901234567890123456789", "999999999999999999999999999"
+};
+static const char* malformed[] = {
+	"", "-", ".", " ", "1e5", "12a34", "3-4", "1.2.3", "+-1", "12 ", "0x10"
+};
+
+/*
+ *	The thresholds the library starts with, set back after each check that changes them.
+ */
+#define KARATSUBA_THRESHOLD	32
+#define TOOM3_THRESHOLD		2000
+#define TOOM4_THRESHOLD		6000
+#define NTT_THRESHOLD		800
+#define NEVER				((size_t) -1)
+#define SAVE_HEADER_BYTES	32				//The segments of a saved number follow this.
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	make_number
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Makes a number of pseudo random digits, the same ones for the same seed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits, at least one.
+ |				seed,				Picks the digits, an odd seed gives a negative number.
+ |	@return:	The number made, or NULL if the memory could not be allocated.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* make_number(size_t digits, unsigned int seed){
+	char* characters = malloc(digits + 2), *digit;
+	unsigned long state = seed;
+	large_number* number;
+	size_t i;
+
+	if( characters == NULL){
+		return NULL;
+	}
+	digit = characters;
+	if( seed % 2 == 1){
+		*digit++ = '-';
+	}
+	for( i = 0; i < digits; i++){
+		state = (state * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+		digit[i] = (char) ('0' + (state >> 16) % 10);
+	}
+	if( digit[0] == '0'){
+		digit[0] = '1';
+	}
+	digit[digits] = '\0';
+	number = stolargenumber(characters);
+	free(characters);
+	return number;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Subroutine:	set_thresholds
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Sets the amount of segments every multiplication method is used from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		karatsuba, toom3, toom4, ntt,	The amount of segments for each method,
+ |												NEVER to leave a method unused.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static void set_thresholds(size_t karatsuba, size_t toom3, size_t toom4, size_t ntt){
+	set_karatsuba_threshold(karatsuba);
+	set_toom_thresholds(toom3, toom4);
+	set_ntt_threshold(ntt);
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_multiply
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Multiplies and squares two numbers with the schoolbook method, then again
+ |				with the thresholds given, and compares the products.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		method,							The name printed when a product differs.
+ |				karatsuba, toom3, toom4, ntt,	The thresholds the products are checked at.
+ |				digits_one, digits_two,			The amount of digits of each number.
+ |	@return:	The amount of products that were different.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_multiply(const char* method, size_t karatsuba, size_t toom3, size_t toom4,
+						  size_t ntt, size_t digits_one, size_t digits_two){
+	large_number* one = make_number(digits_one, (unsigned int) digits_one);
+	large_number* two = make_number(digits_two, (unsigned int) digits_two + 1);
+	large_number* product = init_largenumber(0), *square = init_largenumber(0);
+	large_number* expected_product = init_largenumber(0), *expected_square = init_largenumber(0);
+	int failures = 0;
+
+	set_thresholds(NEVER, NEVER, NEVER, NEVER);
+	multiply_into_largenumber(expected_product, one, two);
+	multiply_into_largenumber(expected_square, one, one);
+
+	set_thresholds(karatsuba, toom3, toom4, ntt);
+	multiply_into_largenumber(product, one, two);
+	multiply_into_largenumber(square, one, one);
+	set_thresholds(KARATSUBA_THRESHOLD, TOOM3_THRESHOLD, TOOM4_THRESHOLD, NTT_THRESHOLD);
+
+	if( compare_largenumber(product, expected_product) != 0){
+		printf("%s gave a different product of %zu and %zu digits\n", method, digits_one,
+			   digits_two);
+		failures++;
+	}
+	if( compare_largenumber(square, expected_square) != 0){
+		printf("%s gave a different square of %zu digits\n", method, digits_one);
+		failures++;
+	}
+
+	free_largenumber(one);
+	free_largenumber(two);
+	free_largenumber(product);
+	free_largenumber(square);
+	free_largenumber(expected_product);
+	free_largenumber(expected_square);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_divmod
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides two numbers into new outputs, then with the outputs being the
+ |				operands in every allowed arrangement, and compares the results.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		dividend, divisor,	The characters of the numbers divided.
+ |	@return:	The amount of arrangements that gave a different result.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_divmod(const char* dividend, const char* divisor){
+	large_number* quotient = init_largenumber(0), *remainder = init_largenumber(0);
+	large_number* number, *divide;
+	int arrangement, failures = 0, same;
+
+	number = stolargenumber((char*) dividend);
+	divide = stolargenumber((char*) divisor);
+	//Dividing by zero leaves every output unchanged, so there is nothing to compare.
+	if( divmod_largenumber(quotient, remainder, number, divide) != 1){
+		arrangement = 6;
+	}
+	else{
+		arrangement = 0;
+	}
+	free_largenumber(number);
+	free_largenumber(divide);
+
+	///Each arrangement writes the quotient and remainder over the operands or NULL.
+	for( ; arrangement < 6; arrangement++){
+		number = stolargenumber((char*) dividend);
+		divide = stolargenumber((char*) divisor);
+		switch( arrangement){
+			case 0:
+				divmod_largenumber(number, divide, number, divide);
+				same = compare_largenumber(number, quotient) == 0
+					   && compare_largenumber(divide, remainder) == 0;
+				break;
+			case 1:
+				divmod_largenumber(divide, number, number, divide);
+				same = compare_largenumber(divide, quotient) == 0
+					   && compare_largenumber(number, remainder) == 0;
+				break;
+			case 2:
+				divmod_largenumber(number, NULL, number, divide);
+				same = compare_largenumber(number, quotient) == 0;
+				break;
+			case 3:
+				divmod_largenumber(divide, NULL, number, divide);
+				same = compare_largenumber(divide, quotient) == 0;
+				break;
+			case 4:
+				divmod_largenumber(NULL, number, number, divide);
+				same = compare_largenumber(number, remainder) == 0;
+				break;
+			default:
+				divmod_largenumber(NULL, divide, number, divide);
+				same = compare_largenumber(divide, remainder) == 0;
+				break;
+		}
+		if( !same){
+			printf("divmod %s / %s failed in arrangement %d\n", dividend, divisor, arrangement);
+			failures++;
+		}
+		free_largenumber(number);
+		free_largenumber(divide);
+	}
+
+	free_largenumber(quotient);
+	free_largenumber(remainder);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_divide
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Divides two numbers and checks that the quotient times the divisor plus the
+ |				remainder is the dividend, with the remainder smaller than the divisor.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits_dividend, digits_divisor,	The amount of digits of each number.
+ |				seed,								Picks the digits and the signs.
+ |	@return:	1 if the quotient or remainder was wrong, otherwise 0.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_divide(size_t digits_dividend, size_t digits_divisor, unsigned int seed){
+	large_number* dividend = make_number(digits_dividend, seed);
+	large_number* divisor = make_number(digits_divisor, seed / 2);
+	large_number* quotient = init_largenumber(0), *remainder = init_largenumber(0);
+	large_number* product = init_largenumber(0);
+	int failures = 0;
+
+	divmod_largenumber(quotient, remainder, dividend, divisor);
+	multiply_into_largenumber(product, quotient, divisor);
+	add_into_largenumber(product, product, remainder);
+	if( compare_largenumber(product, dividend) != 0){
+		printf("divmod of %zu by %zu digits did not give back the dividend\n",
+			   digits_dividend, digits_divisor);
+		failures = 1;
+	}
+	///Only the size of the remainder is compared, whatever the signs.
+	remainder->sign = POSITIVE;
+	divisor->sign = POSITIVE;
+	if( compare_largenumber(remainder, divisor) >= 0){
+		printf("divmod of %zu by %zu digits left a remainder as large as the divisor\n",
+			   digits_dividend, digits_divisor);
+		failures = 1;
+	}
+
+	free_largenumber(dividend);
+	free_largenumber(divisor);
+	free_largenumber(quotient);
+	free_largenumber(remainder);
+	free_largenumber(product);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	make_modulus
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Makes a positive number of pseudo random digits ending in a given digit,
+ |				which decides which factors it shares with MAXVALUE.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits before the last.
+ |				ending,				The last digit.
+ |	@return:	The number made, or NULL if the memory could not be allocated.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* make_modulus(size_t digits, int ending){
+	large_number* leading = make_number(digits, 2 * (unsigned int) digits), *shifted, *modulus;
+
+	shifted = multiply_largenumber(leading, 10);
+	modulus = add_largenumber(shifted, ending);
+	free_largenumber(leading);
+	free_largenumber(shifted);
+	return modulus;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_powmod
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a number to a power modulo a modulus, with and without a kept
+ |				montgomery context, and compares it with the power reduced afterwards.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits of the modulus and the base.
+ |				ending,				The last digit of the modulus.
+ |				exponent,			The power the base is raised to.
+ |				seed,				Picks the digits of the base, and its sign.
+ |	@return:	The amount of powers that were different.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_powmod(size_t digits, int ending, unsigned int exponent, unsigned int seed){
+	large_number* modulus = make_modulus(digits, ending), *base = make_number(digits, seed);
+	large_number* power = init_largenumber(exponent), *expected = init_largenumber(0);
+	large_number* raised, *powered;
+	largenumber_montgomery* context;
+	int failures = 0;
+
+	///The reduced power keeps the sign of the base, the modular one is never negative.
+	raised = pow_largenumber(base, exponent);
+	divmod_largenumber(NULL, expected, raised, modulus);
+	if( expected->sign == NEGATIVE){
+		add_into_largenumber(expected, expected, modulus);
+	}
+
+	powered = powmod_largenumber(base, power, modulus);
+	if( compare_largenumber(powered, expected) != 0){
+		printf("powmod of %zu digits ending in %d to %u was different\n", digits, ending,
+			   exponent);
+		failures++;
+	}
+	free_largenumber(powered);
+
+	///A context can only be made for moduli sharing no factor with MAXVALUE.
+	if( (context = init_largenumber_montgomery(modulus)) != NULL){
+		powered = montgomery_pow_largenumber(context, base, power);
+		if( compare_largenumber(powered, expected) != 0){
+			printf("montgomery_pow of %zu digits to %u was different\n", digits, exponent);
+			failures++;
+		}
+		free_largenumber(powered);
+		free_largenumber_montgomery(context);
+	}
+	else if( ending % 2 == 1 && (MAXVALUE % 5 != 0 || ending != 5)){
+		printf("no montgomery context was made for %zu digits ending in %d\n", digits,
+			   ending);
+		failures++;
+	}
+
+	free_largenumber(modulus);
+	free_largenumber(base);
+	free_largenumber(power);
+	free_largenumber(expected);
+	free_largenumber(raised);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_fermat
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Raises a number to one less than the prime 2^127 - 1 modulo that prime,
+ |				which by fermat's little theorem gives one, to check an exponent too
+ |				large to raise without the modulus.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		seed,				Picks the digits of the base, and its sign.
+ |	@return:	1 if the power was not one, otherwise 0.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_fermat(unsigned int seed){
+	large_number* prime = stolargenumber((char*) "170141183460469231731687303715884105727");
+	large_number* exponent = sub_largenumber(prime, 1), *base = make_number(30, seed);
+	large_number* powered = powmod_largenumber(base, exponent, prime);
+	int failures = 0;
+
+	if( powered->size != 1 || powered->segments[0] != 1){
+		printf("powmod by fermat's little theorem did not give one\n");
+		failures = 1;
+	}
+
+	free_largenumber(prime);
+	free_largenumber(exponent);
+	free_largenumber(base);
+	free_largenumber(powered);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_barrett
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Reduces a number by a barrett context, into a new number and over itself,
+ |				and compares the remainders with the one division gives.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits_number, digits_modulus,	The amount of digits of each number.
+ |				seed,							Picks the digits and the signs.
+ |	@return:	The amount of remainders that were different.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_barrett(size_t digits_number, size_t digits_modulus, unsigned int seed){
+	large_number* number = make_number(digits_number, seed);
+	large_number* modulus = make_number(digits_modulus, seed / 2);
+	large_number* expected = mod_two_largenumbers(number, modulus), *remainder;
+	largenumber_barrett* context = init_largenumber_barrett(modulus);
+	int failures = 0;
+
+	remainder = barrett_mod_largenumber(context, number);
+	if( compare_largenumber(remainder, expected) != 0){
+		printf("barrett_mod of %zu by %zu digits was different\n", digits_number,
+			   digits_modulus);
+		failures++;
+	}
+	free_largenumber(remainder);
+
+	barrett_mod_into_largenumber(context, number, number);
+	if( compare_largenumber(number, expected) != 0){
+		printf("barrett_mod_into of %zu by %zu digits over the number was different\n",
+			   digits_number, digits_modulus);
+		failures++;
+	}
+
+	free_largenumber_barrett(context);
+	free_largenumber(number);
+	free_largenumber(modulus);
+	free_largenumber(expected);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	divides
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Checks whether a number divides another with nothing left over.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		divisor,			The number dividing.
+ |				number,				The number divided.
+ |	@return:	1 if nothing is left over, otherwise 0.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int divides(large_number* divisor, large_number* number){
+	large_number* remainder = mod_two_largenumbers(number, divisor);
+	int exact = remainder != NULL && remainder->size == 1 && remainder->segments[0] == 0;
+
+	free_largenumber(remainder);
+	return exact;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_gcd
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the greatest common divisor of two numbers with a known common
+ |				factor, checking it divides both and is made from them by the
+ |				coefficients, then inverts one number with the divisor taken out modulo
+ |				the other.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits_one, digits_two,	The amount of digits of each number besides the
+ |										common factor.
+ |				digits_common,			The amount of digits of the common factor.
+ |				seed,					Picks the digits and the signs.
+ |	@return:	The amount of checks that failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_gcd(size_t digits_one, size_t digits_two, size_t digits_common,
+					 unsigned int seed){
+	large_number* common = make_number(digits_common, 2 * seed), *one, *two;
+	large_number* divisor, *found = init_largenumber(0);
+	large_number* coefficient_one = init_largenumber(0), *coefficient_two = init_largenumber(0);
+	large_number* made = init_largenumber(0), *part = init_largenumber(0);
+	large_number* inverse = init_largenumber(0);
+	int failures = 0;
+
+	one = make_number(digits_one, seed);
+	two = make_number(digits_two, seed / 2);
+	multiply_into_largenumber(one, one, common);
+	multiply_into_largenumber(two, two, common);
+
+	divisor = gcd_largenumber(one, two);
+	if( !divides(common, divisor) || !divides(divisor, one) || !divides(divisor, two)){
+		printf("gcd of %zu and %zu digits did not divide both\n", digits_one, digits_two);
+		failures++;
+	}
+
+	///Any common divisor divides x * one + y * two, so the divisor made is the greatest.
+	gcdext_largenumber(found, coefficient_one, coefficient_two, one, two);
+	multiply_into_largenumber(made, coefficient_one, one);
+	multiply_into_largenumber(part, coefficient_two, two);
+	add_into_largenumber(made, made, part);
+	if( compare_largenumber(found, divisor) != 0 || compare_largenumber(made, divisor) != 0){
+		printf("gcdext of %zu and %zu digits did not give the divisor\n", digits_one,
+			   digits_two);
+		failures++;
+	}
+
+	///The outputs are written over the numbers.
+	free_largenumber(made);
+	free_largenumber(part);
+	made = copy_largenumber(one);
+	part = copy_largenumber(two);
+	gcdext_largenumber(made, part, NULL, made, part);
+	if( compare_largenumber(made, divisor) != 0
+		|| compare_largenumber(part, coefficient_one) != 0){
+		printf("gcdext of %zu and %zu digits over the numbers was different\n", digits_one,
+			   digits_two);
+		failures++;
+	}
+
+	///With the divisor taken out the numbers share no factor, so each has an inverse.
+	if( modinv_largenumber(inverse, one, two) != -1){
+		printf("modinv of numbers sharing a factor did not fail\n");
+		failures++;
+	}
+	divmod_largenumber(one, NULL, one, divisor);
+	divmod_largenumber(two, NULL, two, divisor);
+	free_largenumber(inverse);
+	inverse = copy_largenumber(one);
+	if( modinv_largenumber(inverse, inverse, two) != 1){
+		printf("modinv of %zu digits modulo %zu digits failed\n", digits_one, digits_two);
+		failures++;
+	}
+	///The sign of the modulus is ignored, so it is reduced by its size.
+	two->sign = POSITIVE;
+	multiply_into_largenumber(made, inverse, one);
+	divmod_largenumber(NULL, made, made, two);
+	if( made->sign == NEGATIVE){
+		add_into_largenumber(made, made, two);
+	}
+	if( made->size != 1 || made->segments[0] != 1){
+		printf("modinv of %zu digits modulo %zu digits was not an inverse\n", digits_one,
+			   digits_two);
+		failures++;
+	}
+
+	free_largenumber(common);
+	free_largenumber(one);
+	free_largenumber(two);
+	free_largenumber(divisor);
+	free_largenumber(found);
+	free_largenumber(coefficient_one);
+	free_largenumber(coefficient_two);
+	free_largenumber(made);
+	free_largenumber(part);
+	free_largenumber(inverse);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_sqrt
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds the square root of a number and what is left, checking the root
+ |				squared is at most the number and one more than it squared is past it,
+ |				and that the remainder makes up the difference.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits of the number.
+ |				seed,				Picks the digits, which must be even for a positive number.
+ |	@return:	The amount of checks that failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_sqrt(size_t digits, unsigned int seed){
+	large_number* number = make_number(digits, seed), *remainder = init_largenumber(0);
+	large_number* root, *square = init_largenumber(0), *above, *left;
+	int failures = 0;
+
+	root = sqrt_largenumber(number, remainder);
+	sqr_into_largenumber(square, root);
+	above = add_largenumber(root, 1);
+	sqr_into_largenumber(above, above);
+	if( compare_largenumber(square, number) > 0 || compare_largenumber(above, number) <= 0){
+		printf("sqrt of %zu digits was not rounded down\n", digits);
+		failures++;
+	}
+	add_into_largenumber(square, square, remainder);
+	if( remainder->sign == NEGATIVE || compare_largenumber(square, number) != 0){
+		printf("sqrt of %zu digits left the wrong remainder\n", digits);
+		failures++;
+	}
+
+	///The remainder may be written over the number.
+	left = copy_largenumber(number);
+	free_largenumber(root);
+	root = sqrt_largenumber(left, left);
+	if( compare_largenumber(left, remainder) != 0){
+		printf("sqrt of %zu digits over the number left a different remainder\n", digits);
+		failures++;
+	}
+
+	free_largenumber(number);
+	free_largenumber(remainder);
+	free_largenumber(root);
+	free_largenumber(square);
+	free_largenumber(above);
+	free_largenumber(left);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_root
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Finds a root of a number, checking that its size raised to the degree is
+ |				at most the size of the number, one more than it raised is past it, and
+ |				that it has the sign of the number.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits of the number.
+ |				degree,				The degree of the root.
+ |				seed,				Picks the digits, and the sign for odd degrees.
+ |	@return:	1 if the root was wrong, otherwise 0.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_root(size_t digits, unsigned int degree, unsigned int seed){
+	large_number* number = make_number(digits, degree % 2 == 1 ? seed : 2 * seed);
+	large_number* root = root_largenumber(number, degree), *raised, *above, *next;
+	char sign = number->sign;
+	int failures = 0;
+
+	if( root->sign != sign){
+		printf("root of degree %u of %zu digits has the wrong sign\n", degree, digits);
+		failures = 1;
+	}
+	number->sign = POSITIVE;
+	root->sign = POSITIVE;
+	raised = pow_largenumber(root, degree);
+	next = add_largenumber(root, 1);
+	above = pow_largenumber(next, degree);
+	if( compare_largenumber(raised, number) > 0 || compare_largenumber(above, number) <= 0){
+		printf("root of degree %u of %zu digits was not rounded towards zero\n", degree,
+			   digits);
+		failures = 1;
+	}
+
+	free_largenumber(number);
+	free_largenumber(root);
+	free_largenumber(raised);
+	free_largenumber(next);
+	free_largenumber(above);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_negative_root
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Takes even roots of a negative number, which should give NULL.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of roots that were found.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_negative_root(void){
+	large_number* number = init_largenumber(-16), *root;
+	int failures = 0;
+
+	if( (root = sqrt_largenumber(number, NULL)) != NULL){
+		printf("sqrt of a negative number was found\n");
+		free_largenumber(root);
+		failures++;
+	}
+	if( (root = root_largenumber(number, 4)) != NULL){
+		printf("root of degree 4 of a negative number was found\n");
+		free_largenumber(root);
+		failures++;
+	}
+
+	free_largenumber(number);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	load_bytes
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Loads a saved number from bytes in memory, through a temporary file.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		data, length,		The saved number and the amount of bytes it takes.
+ |	@return:	The number loaded, or NULL if it was rejected.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static large_number* load_bytes(const void* data, size_t length){
+	FILE* stream = tmpfile();
+	large_number* number;
+
+	if( stream == NULL){
+		return NULL;
+	}
+	fwrite(data, 1, length, stream);
+	rewind(stream);
+	number = load_largenumber(stream);
+	fclose(stream);
+	return number;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_saved
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Saves a number, then loads and views it, which should give the number
+ |				back, and damages the saved number, which should then be rejected.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		digits,				The amount of digits of the number.
+ |				seed,				Picks the digits and the sign.
+ |	@return:	The amount of checks that failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_saved(size_t digits, unsigned int seed){
+	large_number* number = make_number(digits, seed), *loaded, view;
+	FILE* stream = tmpfile();
+	char* data;
+	size_t length;
+	int failures = 0;
+
+	if( stream == NULL || !save_largenumber(stream, number)){
+		printf("a number of %zu digits could not be saved\n", digits);
+		free_largenumber(number);
+		return 1;
+	}
+	///Memory from malloc is aligned for the segments, as a view needs.
+	length = (size_t) ftell(stream);
+	data = malloc(length);
+	rewind(stream);
+	length = fread(data, 1, length, stream);
+	fclose(stream);
+
+	loaded = load_bytes(data, length);
+	if( loaded == NULL || compare_largenumber(loaded, number) != 0){
+		printf("a saved number of %zu digits was loaded differently\n", digits);
+		failures++;
+	}
+	free_largenumber(loaded);
+	if( !view_largenumber(&view, data, length) || compare_largenumber(&view, number) != 0){
+		printf("a saved number of %zu digits was viewed differently\n", digits);
+		failures++;
+	}
+	if( view_largenumber(&view, data, length - 1)){
+		printf("a saved number of %zu digits missing a byte was viewed\n", digits);
+		failures++;
+	}
+
+	data[0] = 'X';
+	loaded = load_bytes(data, length);
+	if( view_largenumber(&view, data, length) || loaded != NULL){
+		printf("a saved number of %zu digits with a damaged header was used\n", digits);
+		free_largenumber(loaded);
+		failures++;
+	}
+	data[0] = 'L';
+
+#if !defined(LARGENUMBER_BINARY)
+	///Any 32 bits are a segment in base 2^32, but in base 10^9 they may be out of range.
+	*(segment*) (data + SAVE_HEADER_BYTES) = MAXVALUE;
+	loaded = load_bytes(data, length);
+	if( view_largenumber(&view, data, length) || loaded != NULL){
+		printf("a saved number of %zu digits with a segment out of range was used\n",
+			   digits);
+		free_largenumber(loaded);
+		failures++;
+	}
+#endif
+
+	free(data);
+	free_largenumber(number);
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_malformed
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Converts characters that are not a number, which should give NULL.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		characters,			The characters converted.
+ |	@return:	1 if they were converted into a number, otherwise 0.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_malformed(const char* characters){
+	large_number* number = stolargenumber((char*) characters);
+
+	if( number != NULL){
+		printf("\"%s\" was converted into a number\n", characters);
+		free_largenumber(number);
+		return 1;
+	}
+	return 0;
+}
+
+int main(){
+	size_t i, j;
+	int failures = 0;
+
+	for( i = 0; i < sizeof(dividends) / sizeof(dividends[0]); i++){
+		for( j = 0; j < sizeof(divisors) / sizeof(divisors[0]); j++){
+			failures += check_divmod(dividends[i], divisors[j]);
+			failures += check_divmod(divisors[j], dividends[i]);
+		}
+	}
+	///Divisors past 60 segments are divided with burnikel and ziegler's method.
+	failures += check_divide(1200, 600, 4);
+	failures += check_divide(1200, 600, 7);
+	failures += check_divide(9000, 700, 10);
+	failures += check_divide(5000, 2600, 13);
+	failures += check_divide(700, 1200, 2);
+	failures += check_multiply("Karatsuba", KARATSUBA_THRESHOLD, NEVER, NEVER, NEVER, 900, 900);
+	failures += check_multiply("Karatsuba", KARATSUBA_THRESHOLD, NEVER, NEVER, NEVER, 2500, 700);
+	failures += check_multiply("Toom-3", 8, 40, NEVER, NEVER, 900, 850);
+	failures += check_multiply("Toom-4", 8, 20, 40, NEVER, 1200, 1000);
+	failures += check_multiply("Blocked toom-3", 8, 20, NEVER, NEVER, 4000, 400);
+	failures += check_multiply("Blocked toom-4", 8, 20, 40, NEVER, 6000, 900);
+	failures += check_multiply("Transform", 8, NEVER, NEVER, 16, 900, 850);
+	failures += check_multiply("Transform", 8, NEVER, NEVER, 16, 5000, 300);
+	failures += check_multiply("Transform", KARATSUBA_THRESHOLD, TOOM3_THRESHOLD,
+							   TOOM4_THRESHOLD, NTT_THRESHOLD, 8000, 7800);
+	///Odd moduli use montgomery's method, even ones and in base 10^9 multiples of five are
+	///reduced by division.
+	for( i = 0; i < 4; i++){
+		failures += check_powmod(25, 7, (unsigned int) (5 * i), (unsigned int) i);
+		failures += check_powmod(25, 4, (unsigned int) (5 * i), (unsigned int) i);
+		failures += check_powmod(25, 5, (unsigned int) (5 * i), (unsigned int) i);
+	}
+	failures += check_powmod(400, 3, 45, 8);
+	failures += check_powmod(400, 8, 45, 9);
+	failures += check_powmod(400, 5, 45, 11);
+	failures += check_fermat(3);
+	failures += check_fermat(4);
+	///Numbers over twice the length of the modulus are reduced a part at a time.
+	failures += check_barrett(30, 40, 4);
+	failures += check_barrett(70, 40, 6);
+	failures += check_barrett(75, 40, 9);
+	failures += check_barrett(900, 40, 13);
+	failures += check_barrett(1500, 800, 10);
+	failures += check_barrett(9000, 800, 7);
+	///Numbers past 120 segments are reduced with the half gcd.
+	failures += check_gcd(30, 20, 5, 2);
+	failures += check_gcd(20, 45, 12, 7);
+	failures += check_gcd(1500, 1400, 200, 12);
+	failures += check_gcd(1800, 900, 400, 9);
+	failures += check_sqrt(1, 4);
+	failures += check_sqrt(19, 6);
+	failures += check_sqrt(400, 8);
+	failures += check_sqrt(4000, 10);
+	for( i = 2; i < 8; i++){
+		failures += check_root(12, (unsigned int) i, 1);
+		failures += check_root(700, (unsigned int) i, 3);
+	}
+	failures += check_negative_root();
+	failures += check_saved(1, 2);
+	failures += check_saved(30, 3);
+	failures += check_saved(2000, 4);
+	for( i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++){
+		failures += check_malformed(malformed[i]);
+	}
+	printf("%d failures\n", failures);
+
+	return failures != 0;
+}
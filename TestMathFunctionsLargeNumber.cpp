@@ -0,0 +1,281 @@
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Filename:	TestMathFunctionsLargeNumber.cpp
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Checks that the C++ classes give the same results as the large number
+ |				functions they are built on, whether numbers are moved, assigned or
+ |				changed in place, that equal numbers hash the same, that misuse throws,
+ |				and that BigInt overflows and works as a constant expression.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Dependancy:	MathFunctionsLargeNumber.hpp,	cstdio,	functional,	stdexcept,
+ |				unordered_set,	utility
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "MathFunctionsLargeNumber.hpp"
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	differs
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Compares a result against the number it should be, printing both when
+ |				they are different.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		operation,	What gave the result, printed when it is wrong.
+ |	@param:		result,		The number given.
+ |	@param:		expected,	The number it should be.
+ |	@return:	1 if the numbers are different, 0 if they are equal.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int differs(const char* operation, const LargeNumber& result,
+				   const LargeNumber& expected){
+	if( result != expected){
+		printf("%s gave %s instead of %s\n", operation, result.to_string().c_str(),
+			   expected.to_string().c_str());
+		return 1;
+	}
+	return 0;
+}
+
+static const char* const one_characters = "123456789012345678901234567890";
+static const char* const product_characters = "-121932631124828532112482853211126352690";
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_moved
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Assigns numbers and lazy expressions to numbers that were moved from.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of assignments that gave a different result.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_moved(){
+	int failures = 0;
+	LargeNumber one(one_characters), two(-987654321), expected(product_characters);
+
+	LargeNumber moved(one), taken(std::move(moved));
+	moved = one * two;
+	failures += differs("Assigning a product to a moved number", moved, expected);
+	LargeNumber sum(one), summed(std::move(sum));
+	sum = one * two + one;
+	failures += differs("Assigning a sum to a moved number", sum, expected + one);
+	LargeNumber copy(one), copied(std::move(copy));
+	copy = taken;
+	failures += differs("Copying into a moved number", copy, one);
+
+	LargeNumber kept(one), moving(one);
+	kept = std::move(moving);
+	failures += differs("Moving a number", kept, one);
+	failures += differs("Moving a number into a new one", LargeNumber(std::move(kept)), one);
+	failures += differs("Negating a temporary", -LargeNumber(two), LargeNumber(987654321));
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_compound
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Changes numbers in place with every compound operator, including with
+ |				expressions that read the number being changed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of operations that gave a different result.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_compound(){
+	int failures = 0;
+	const LargeNumber one(one_characters), two(-987654321);
+	LargeNumber number(one);
+
+	number += two;
+	failures += differs("+=", number, LargeNumber("123456789012345678900246913569"));
+	number = one;
+	number -= two;
+	failures += differs("-=", number, LargeNumber("123456789012345678902222222211"));
+	number = one;
+	number *= two;
+	failures += differs("*=", number, LargeNumber(product_characters));
+	///Division truncates, leaving the remainder with the sign of the dividend.
+	number = one;
+	number /= two;
+	failures += differs("/=", number, LargeNumber("-124999998873437499901"));
+	number = one;
+	number %= two;
+	failures += differs("%=", number, LargeNumber(574845669));
+
+	number = one;
+	number += number;
+	failures += differs("+= itself", number, LargeNumber("246913578024691357802469135780"));
+	number = one;
+	number *= number;
+	failures += differs("*= itself", number, LargeNumber(
+		"15241578753238836750495351562536198787501905199875019052100"));
+	number = one;
+	number -= number * two;
+	failures += differs("-= a product of itself", number,
+						LargeNumber("121932631248285321124828532112360920580"));
+	number = one;
+	number += two * one;
+	failures += differs("+= a product", number,
+						LargeNumber("-121932631001371743100137174309891784800"));
+	number = one;
+	number = number * two * number;
+	failures += differs("Assigning a product of itself", number, LargeNumber(
+		"-15053411114498129861640332861152978451391217466388931226763889124100"));
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_hash
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Hashes equal numbers made in different ways, and keeps them in a set.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of numbers that hashed or were kept differently.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_hash(){
+	int failures = 0;
+	std::hash<LargeNumber> hasher;
+	const LargeNumber one(one_characters), two(-987654321);
+	const LargeNumber product = one * two;
+	std::unordered_set<LargeNumber> kept;
+
+	if( hasher(product) != hasher(LargeNumber(product_characters))){
+		printf("Equal products hashed differently\n");
+		failures++;
+	}
+	if( hasher(LargeNumber("-0")) != hasher(LargeNumber(0))){
+		printf("Negative zero hashed differently from zero\n");
+		failures++;
+	}
+	kept.insert(product);
+	kept.insert(one);
+	kept.insert(LargeNumber(product_characters));
+	if( kept.size() != 2 || kept.count(one * 1) != 1 || kept.count(two) != 0){
+		printf("A set of numbers kept %zu numbers\n", kept.size());
+		failures++;
+	}
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	throws
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Runs an operation that should throw an exception of a given type.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@param:		operation,	What is run, printed when it does not throw.
+ |	@param:		run,		Runs the operation.
+ |	@return:	1 if nothing or something else was thrown, 0 if the exception was.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+template<typename Exception, typename Operation>
+static int throws(const char* operation, Operation run){
+	try{
+		run();
+	}
+	catch( const Exception&){
+		return 0;
+	}
+	catch( ...){
+		printf("%s threw the wrong exception\n", operation);
+		return 1;
+	}
+	printf("%s did not throw\n", operation);
+	return 1;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_exceptions
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Misuses numbers in every way that should throw.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of misuses that did not throw what they should.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_exceptions(){
+	int failures = 0;
+
+	failures += throws<std::invalid_argument>("Converting 12a34", [](){
+		LargeNumber number("12a34");
+	});
+	failures += throws<std::invalid_argument>("Converting nothing", [](){
+		LargeNumber number((std::string()));
+	});
+	failures += throws<std::domain_error>("Dividing by zero", [](){
+		LargeNumber number(7);
+		number /= LargeNumber(0);
+	});
+	failures += throws<std::domain_error>("Reducing by zero", [](){
+		LargeNumber number(7);
+		number %= LargeNumber(0);
+	});
+	failures += throws<std::domain_error>("The square root of -4", [](){
+		sqrt(LargeNumber(-4));
+	});
+	return failures;
+}
+
+/*
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Function:	check_bigint
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	Purpose:	Works out BigInt values while compiling and running, converts them to and
+ |				from LargeNumber, and overflows them.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ |	@return:	The amount of checks that failed.
+ --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+static int check_bigint(){
+	int failures = 0;
+	constexpr BigInt<2> product = BigInt<2>(123456789) * BigInt<2>(-987654321);
+	constexpr BigInt<2> sum = product + 121932631112635269LL - 1;
+	const LargeNumber large(one_characters);
+
+	static_assert(product == BigInt<2>(-121932631112635269LL), "a constant product");
+	static_assert(sum == -1 && sum < 0 && -sum > 0, "a constant sum");
+	static_assert(BigIntBits<64>(-1) * 0 == 0, "a constant zero");
+
+	failures += differs("Converting a BigInt", LargeNumber(product),
+						LargeNumber(-121932631112635269LL));
+	failures += differs("Converting through a BigInt", LargeNumber(BigInt<4>(large)), large);
+	failures += differs("Multiplying BigInts", LargeNumber(BigInt<4>(large) * 3),
+						large * 3);
+
+	failures += throws<std::overflow_error>("Adding past one segment", [](){
+		BigInt<1> most(MAXVALUE - 1);
+		most += 1;
+	});
+	failures += throws<std::overflow_error>("Multiplying past two segments", [](){
+		BigInt<2> square = BigInt<2>(MAXVALUE) * BigInt<2>(MAXVALUE);
+		(void) square;
+	});
+	failures += throws<std::overflow_error>("Converting a long long into one segment", [](){
+		BigInt<1> number(MAXVALUE);
+		(void) number;
+	});
+	failures += throws<std::overflow_error>("Converting a long number into two segments",
+											[&large](){
+		BigInt<2> number(large);
+		(void) number;
+	});
+	return failures;
+}
+
+int main(){
+	int failures = check_moved();
+
+	failures += check_compound();
+	failures += check_hash();
+	failures += check_exceptions();
+	failures += check_bigint();
+
+	printf("%d failures\n", failures);
+	return failures != 0;
+}
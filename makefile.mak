@@ -1,6 +1,11 @@
 #makefile
 CC = gcc
+CXX = g++
 WARNINGS = -Wall
+#Set to -DLARGENUMBER_BINARY to hold segments in base 2^32 instead of base 10^9.
+RADIX =
+#Set to -mavx2 or -mavx512f to add and negate segments with vector instructions.
+ARCH =
 
 all: LargeNumbers.dll
 
@@ -8,7 +13,19 @@ LargeNumbers.dll: MathFunctionsLargeNumber.o
 	$(CC) -shared -o LargeNumbers.dll MathFunctionsLargeNumber.o -Wl,--out-implib,libmessage.a
 	
 MathFunctionsLargeNumber.o: MathFunctionsLargeNumber.c MathFunctionsLargeNumber.h
-	$(CC) -c -DBUILD_DLL MathFunctionsLargeNumber.c
+	$(CC) -c -DBUILD_DLL $(RADIX) $(ARCH) MathFunctionsLargeNumber.c
 	
+#Checks the functions, with the library built under another name for its main.
+test: TestMathFunctionsLargeNumber.c MathFunctionsLargeNumber.c MathFunctionsLargeNumber.h
+	$(CC) $(WARNINGS) $(RADIX) $(ARCH) -Dmain=largenumber_main -c MathFunctionsLargeNumber.c -o TestLibrary.o
+	$(CC) $(WARNINGS) $(RADIX) $(ARCH) -o TestLargeNumbers TestMathFunctionsLargeNumber.c TestLibrary.o -lpthread
+	./TestLargeNumbers
+
+#Checks the C++ classes on the same library, from C++14 so BigInt can be a constant.
+testcpp: TestMathFunctionsLargeNumber.cpp MathFunctionsLargeNumber.hpp MathFunctionsLargeNumber.c MathFunctionsLargeNumber.h
+	$(CC) $(WARNINGS) $(RADIX) $(ARCH) -Dmain=largenumber_main -c MathFunctionsLargeNumber.c -o TestLibrary.o
+	$(CXX) $(WARNINGS) $(RADIX) $(ARCH) -std=c++14 -o TestLargeNumbersCpp TestMathFunctionsLargeNumber.cpp TestLibrary.o -lpthread
+	./TestLargeNumbersCpp
+
 clean:
-	rm -rf *o LargeNumbers.dll
+	rm -rf *o LargeNumbers.dll TestLargeNumbers TestLargeNumbersCpp